@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <math/Utility.h>
+
+#include "BoundingVolume.h"
+#include "HullPlane.h"
+#include "Predicates.h"
+
+namespace {
+
+// The points used by the hull's faces. Points that were not added to the hull
+// can't be extreme in any direction.
+template<typename T>
+Ds::Vector<Math::Vector<T, 3>> HullVertices(const ConvexHull<T>& hull) {
+  Ds::Vector<uint32_t> points = hull.mFaceVertices;
+  uint32_t* pointsEnd = points.Data() + points.Size();
+  std::sort(points.Data(), pointsEnd);
+  pointsEnd = std::unique(points.Data(), pointsEnd);
+  Ds::Vector<Math::Vector<T, 3>> vertices;
+  for (const uint32_t* point = points.Data(); point < pointsEnd; ++point) {
+    vertices.Push(hull.mPoints[*point]);
+  }
+  return vertices;
+}
+
+// Calls visit with the plane and area of every hull face.
+template<typename T, typename F>
+void VisitFacePlanes(const ConvexHull<T>& hull, F visit) {
+  Ds::Vector<Math::Vector<T, 3>> facePoints;
+  size_t offset = 0;
+  for (uint32_t faceSize: hull.mFaceSizes) {
+    facePoints.Clear();
+    for (uint32_t i = 0; i < faceSize; ++i) {
+      facePoints.Push(hull.mPoints[hull.mFaceVertices[offset + i]]);
+    }
+    offset += faceSize;
+    T area;
+    HullPlane<T> plane = HullPlane<T>::Newell(facePoints, &area);
+    visit(plane, area);
+  }
+}
+
+// The counterclockwise convex polygon around a set of 2d points without any
+// colinear corners. The lower chain is built from left to right and the upper
+// chain from right to left. The points are sorted in the process.
+template<typename T>
+Ds::Vector<Math::Vector<T, 2>> ConvexPolygon(
+  Ds::Vector<Math::Vector<T, 2>>* points) {
+  using Vector2 = Math::Vector<T, 2>;
+  std::sort(
+    points->Data(),
+    points->Data() + points->Size(),
+    [](const Vector2& a, const Vector2& b) {
+      if (a[0] != b[0]) {
+        return a[0] < b[0];
+      }
+      return a[1] < b[1];
+    });
+  Ds::Vector<Vector2> polygon;
+  size_t count = points->Size();
+  for (int chain = 0; chain < 2; ++chain) {
+    size_t chainStart = polygon.Size();
+    for (size_t i = 0; i < count; ++i) {
+      const Vector2& point = (*points)[chain == 0 ? i : count - 1 - i];
+      while (
+        polygon.Size() >= chainStart + 2 &&
+        Predicates::Orient2d(
+          polygon[polygon.Size() - 2], polygon.Top(), point) <= 0.0) {
+        polygon.Pop();
+      }
+      polygon.Push(point);
+    }
+    // The last point of each chain is the first point of the other.
+    polygon.Pop();
+  }
+  return polygon;
+}
+
+} // namespace
+
+template<typename T>
+Obb<T> Obb<T>::Fit(const ConvexHull<T>& hull) {
+  using Vector2 = Math::Vector<T, 2>;
+  Obb best;
+  best.mCenter = {0, 0, 0};
+  best.mAxes[0] = {1, 0, 0};
+  best.mAxes[1] = {0, 1, 0};
+  best.mAxes[2] = {0, 0, 1};
+  best.mHalfExtents = {0, 0, 0};
+  Ds::Vector<Vector3> vertices = HullVertices(hull);
+  if (vertices.Empty()) {
+    return best;
+  }
+
+  // The coordinate axes are always tried so the box is never worse than the
+  // axis aligned box. A colinear hull has no face normals, so its direction is
+  // tried instead.
+  Ds::Vector<Vector3> candidateAxes;
+  candidateAxes.Push({1, 0, 0});
+  candidateAxes.Push({0, 1, 0});
+  candidateAxes.Push({0, 0, 1});
+  if (hull.mDimension == 1 && vertices.Size() == 2) {
+    candidateAxes.Push(Math::Normalize(vertices[1] - vertices[0]));
+  }
+  VisitFacePlanes(hull, [&](const HullPlane<T>& plane, T area) {
+    if (area > (T)0) {
+      candidateAxes.Push(plane.Normal());
+    }
+  });
+
+  // Flat hulls give every box a volume of zero, so ties are broken with the
+  // surface area.
+  T bestVolume = std::numeric_limits<T>::max();
+  T bestSurface = std::numeric_limits<T>::max();
+  Ds::Vector<Vector2> projected;
+  for (const Vector3& normal: candidateAxes) {
+    // u and v span the plane perpendicular to the normal and are built from
+    // the coordinate axis the normal is least aligned with.
+    int least = 0;
+    for (int i = 1; i < 3; ++i) {
+      if (Math::Abs(normal[i]) < Math::Abs(normal[least])) {
+        least = i;
+      }
+    }
+    Vector3 helper = {0, 0, 0};
+    helper[least] = (T)1;
+    Vector3 u = Math::Normalize(Math::Cross(normal, helper));
+    Vector3 v = Math::Cross(normal, u);
+
+    T minN = std::numeric_limits<T>::max();
+    T maxN = std::numeric_limits<T>::lowest();
+    projected.Clear();
+    for (const Vector3& vertex: vertices) {
+      T n = Math::Dot(vertex, normal);
+      minN = Math::Min(minN, n);
+      maxN = Math::Max(maxN, n);
+      projected.Push({Math::Dot(vertex, u), Math::Dot(vertex, v)});
+    }
+    Ds::Vector<Vector2> polygon = ConvexPolygon(&projected);
+
+    auto consider = [&](const Vector2& e, T minE, T maxE, T minF, T maxF) {
+      Vector3 halfExtents = {
+        (maxE - minE) / (T)2, (maxF - minF) / (T)2, (maxN - minN) / (T)2};
+      T volume = (T)8 * halfExtents[0] * halfExtents[1] * halfExtents[2];
+      T surface = (T)8 *
+        (halfExtents[0] * halfExtents[1] + halfExtents[1] * halfExtents[2] +
+         halfExtents[2] * halfExtents[0]);
+      if (
+        volume > bestVolume ||
+        (volume == bestVolume && surface >= bestSurface)) {
+        return;
+      }
+      bestVolume = volume;
+      bestSurface = surface;
+      Vector2 f = {-e[1], e[0]};
+      Vector2 center2 =
+        e * ((minE + maxE) / (T)2) + f * ((minF + maxF) / (T)2);
+      best.mAxes[0] = u * e[0] + v * e[1];
+      best.mAxes[1] = u * f[0] + v * f[1];
+      best.mAxes[2] = normal;
+      best.mCenter =
+        u * center2[0] + v * center2[1] + normal * ((minN + maxN) / (T)2);
+      best.mHalfExtents = halfExtents;
+    };
+
+    // A polygon without area is a point or a segment and the rectangle around
+    // it is aligned with the segment.
+    size_t size = polygon.Size();
+    if (size < 3) {
+      Vector2 e = {1, 0};
+      Vector2 span = polygon[size - 1] - polygon[0];
+      if (Math::MagnitudeSq(span) > (T)0) {
+        e = Math::Normalize(span);
+      }
+      Vector2 f = {-e[1], e[0]};
+      T first = Math::Dot(polygon[0], e);
+      T last = Math::Dot(polygon.Top(), e);
+      T offset = Math::Dot(polygon[0], f);
+      consider(
+        e, Math::Min(first, last), Math::Max(first, last), offset, offset);
+      continue;
+    }
+
+    // The minimum area rectangle has a side on one of the polygon's edges.
+    // Each edge is placed on the bottom of the rectangle and the calipers on
+    // the right, top, and left only ever advance counterclockwise as the edges
+    // are visited in order.
+    size_t right = 0;
+    size_t top = 0;
+    size_t left = 0;
+    auto next = [size](size_t i) {
+      return (i + 1) % size;
+    };
+    auto advance = [&](size_t* caliper, const Vector2& direction) {
+      while (
+        Math::Dot(polygon[next(*caliper)], direction) >
+        Math::Dot(polygon[*caliper], direction)) {
+        *caliper = next(*caliper);
+      }
+    };
+    for (size_t i = 0; i < size; ++i) {
+      Vector2 e = Math::Normalize(polygon[next(i)] - polygon[i]);
+      Vector2 f = {-e[1], e[0]};
+      if (i == 0) {
+        for (size_t p = 1; p < size; ++p) {
+          if (Math::Dot(polygon[p], e) > Math::Dot(polygon[right], e)) {
+            right = p;
+          }
+          if (Math::Dot(polygon[p], f) > Math::Dot(polygon[top], f)) {
+            top = p;
+          }
+          if (Math::Dot(polygon[p], e) < Math::Dot(polygon[left], e)) {
+            left = p;
+          }
+        }
+      }
+      else {
+        advance(&right, e);
+        advance(&top, f);
+        advance(&left, e * (T)-1);
+      }
+      consider(
+        e,
+        Math::Dot(polygon[left], e),
+        Math::Dot(polygon[right], e),
+        Math::Dot(polygon[i], f),
+        Math::Dot(polygon[top], f));
+    }
+  }
+  return best;
+}
+
+template<typename T>
+T Obb<T>::Volume() const {
+  return (T)8 * mHalfExtents[0] * mHalfExtents[1] * mHalfExtents[2];
+}
+
+template<typename T>
+Ds::Vector<typename Kdop<T>::Vector3> Kdop<T>::StandardAxes(uint32_t k) {
+  Ds::Vector<Vector3> axes;
+  axes.Push({1, 0, 0});
+  axes.Push({0, 1, 0});
+  axes.Push({0, 0, 1});
+  if (k == 14 || k == 26) {
+    T c = (T)1 / std::sqrt((T)3);
+    axes.Push({c, c, c});
+    axes.Push({c, c, -c});
+    axes.Push({c, -c, c});
+    axes.Push({-c, c, c});
+  }
+  if (k == 18 || k == 26) {
+    T c = (T)1 / std::sqrt((T)2);
+    axes.Push({c, c, 0});
+    axes.Push({c, -c, 0});
+    axes.Push({c, 0, c});
+    axes.Push({c, 0, -c});
+    axes.Push({0, c, c});
+    axes.Push({0, c, -c});
+  }
+  return axes;
+}
+
+template<typename T>
+Ds::Vector<typename Kdop<T>::Vector3> Kdop<T>::FaceAxes(
+  const ConvexHull<T>& hull, uint32_t count) {
+  struct AreaNormal {
+    T mArea;
+    Vector3 mNormal;
+  };
+  Ds::Vector<AreaNormal> areaNormals;
+  VisitFacePlanes(hull, [&](const HullPlane<T>& plane, T area) {
+    if (area > (T)0) {
+      areaNormals.Push({area, plane.Normal()});
+    }
+  });
+  std::sort(
+    areaNormals.Data(),
+    areaNormals.Data() + areaNormals.Size(),
+    [](const AreaNormal& a, const AreaNormal& b) {
+      return a.mArea > b.mArea;
+    });
+
+  // A slab is bounded on both sides, so antiparallel normals are also
+  // repeats.
+  constexpr T nParallelCosine = (T)0.999;
+  Ds::Vector<Vector3> axes;
+  for (const AreaNormal& areaNormal: areaNormals) {
+    if (axes.Size() >= count) {
+      break;
+    }
+    bool repeat = false;
+    for (const Vector3& axis: axes) {
+      if (Math::Abs(Math::Dot(axis, areaNormal.mNormal)) > nParallelCosine) {
+        repeat = true;
+        break;
+      }
+    }
+    if (!repeat) {
+      axes.Push(areaNormal.mNormal);
+    }
+  }
+  return axes;
+}
+
+template<typename T>
+Kdop<T> Kdop<T>::Fit(
+  const ConvexHull<T>& hull, const Ds::Vector<Vector3>& axes) {
+  Kdop kdop;
+  kdop.mAxes = axes;
+  kdop.mMins.Resize(axes.Size(), std::numeric_limits<T>::max());
+  kdop.mMaxes.Resize(axes.Size(), std::numeric_limits<T>::lowest());
+  Ds::Vector<Vector3> vertices = HullVertices(hull);
+  for (const Vector3& vertex: vertices) {
+    for (size_t a = 0; a < axes.Size(); ++a) {
+      T distance = Math::Dot(vertex, axes[a]);
+      kdop.mMins[a] = Math::Min(kdop.mMins[a], distance);
+      kdop.mMaxes[a] = Math::Max(kdop.mMaxes[a], distance);
+    }
+  }
+  return kdop;
+}
+
+template struct Obb<float>;
+template struct Obb<double>;
+template struct Kdop<float>;
+template struct Kdop<double>;
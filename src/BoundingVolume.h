@@ -0,0 +1,61 @@
+#ifndef BoundingVolume_h
+#define BoundingVolume_h
+
+#include <ds/Vector.h>
+#include <math/Vector.h>
+#include <stdint.h>
+
+#include "ConvexHull.h"
+
+// Bounding volumes are fit to a finished hull rather than to the points it was
+// built from. Only hull vertices can be extreme in any direction, so the
+// result is the same while far fewer points are visited.
+
+// An oriented bounding box. The axes are orthonormal and the box spans
+// mHalfExtents[i] along mAxes[i] in both directions from mCenter.
+template<typename T>
+struct Obb {
+  using Vector3 = Math::Vector<T, 3>;
+
+  // Every face normal of the hull is tried as one of the box axes. The other
+  // two axes come from the minimum area rectangle around the vertices
+  // projected onto the face, which rotating calipers find in linear time. The
+  // box with the least volume is kept.
+  static Obb Fit(const ConvexHull<T>& hull);
+  T Volume() const;
+
+  Vector3 mCenter;
+  Vector3 mAxes[3];
+  Vector3 mHalfExtents;
+};
+
+// A discrete oriented polytope. It is the intersection of slabs, where slab i
+// contains all points whose projection onto mAxes[i] is within mMins[i] and
+// mMaxes[i].
+template<typename T>
+struct Kdop {
+  using Vector3 = Math::Vector<T, 3>;
+
+  // The k / 2 axes of the common 6, 14, 18, and 26 sided polytopes. The 6
+  // sided polytope only uses the coordinate axes. The 14 sided one adds the
+  // box diagonals, the 18 sided one adds the face diagonals instead, and the
+  // 26 sided one adds both. Other values of k are treated as 6.
+  static Ds::Vector<Vector3> StandardAxes(uint32_t k);
+  // The normals of up to count of the largest hull faces. Faces that are
+  // nearly parallel to an earlier face would only repeat its slab and are
+  // skipped.
+  static Ds::Vector<Vector3> FaceAxes(
+    const ConvexHull<T>& hull, uint32_t count);
+  static Kdop Fit(const ConvexHull<T>& hull, const Ds::Vector<Vector3>& axes);
+
+  Ds::Vector<Vector3> mAxes;
+  Ds::Vector<T> mMins;
+  Ds::Vector<T> mMaxes;
+};
+
+extern template struct Obb<float>;
+extern template struct Obb<double>;
+extern template struct Kdop<float>;
+extern template struct Kdop<double>;
+
+#endif
@@ -0,0 +1,1452 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+
+#include <ds/List.h>
+#include <math/Utility.h>
+
+#include "ConvexHull.h"
+#include "Hash.h"
+#include "HullPlane.h"
+#include "MappedFile.h"
+#include "Predicates.h"
+
+namespace {
+
+template<typename T>
+bool NearlyEqual(T a, T b, T epsilon) {
+  return Math::Abs(a - b) <= epsilon;
+}
+
+template<typename T>
+bool NearlyEqual(
+  const Math::Vector<T, 3>& a, const Math::Vector<T, 3>& b, T epsilon) {
+  for (int i = 0; i < 3; ++i) {
+    if (!NearlyEqual(a[i], b[i], epsilon)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The squared distance from a point to the line through a and b.
+template<typename T>
+T LineDistanceSq(
+  const Math::Vector<T, 3>& a,
+  const Math::Vector<T, 3>& b,
+  const Math::Vector<T, 3>& point) {
+  Math::Vector<T, 3> direction = Math::Normalize(b - a);
+  Math::Vector<T, 3> offset = point - a;
+  return Math::MagnitudeSq(offset - direction * Math::Dot(offset, direction));
+}
+
+template<typename T>
+T Angle(const Math::Vector<T, 3>& a, const Math::Vector<T, 3>& b) {
+  T cosine = Math::Dot(a, b) / (Math::Magnitude(a) * Math::Magnitude(b));
+  cosine = Math::Max((T)-1, Math::Min((T)1, cosine));
+  return std::acos(cosine);
+}
+
+// The mesh a hull is built in. Elements are taken from the end of their pools
+// and are never freed on their own. Removed faces are flagged as dead instead.
+// An element's index is therefore stable and the whole mesh is released at
+// once when the build is done.
+template<typename T>
+struct HalfEdgeMesh {
+  using Vector3 = Math::Vector<T, 3>;
+  struct Vertex {
+    uint32_t mPoint;
+    uint32_t mHalfEdge;
+  };
+  struct HalfEdge {
+    uint32_t mVertex;
+    uint32_t mTwin;
+    uint32_t mNext;
+    uint32_t mPrev;
+    uint32_t mFace;
+  };
+  // A point outside of the hull that is closer to a face's plane than to the
+  // plane of any other face it lies in front of.
+  struct Conflict {
+    uint32_t mPoint;
+    T mDistance;
+  };
+  struct Face {
+    uint32_t mHalfEdge;
+    bool mDead;
+    HullPlane<T> mPlane;
+    // The points of the largest triangle fanning out from the face's first
+    // vertex. Exact side tests against the face use their orientation.
+    uint32_t mSupport[3];
+    Ds::Vector<Conflict> mConflicts;
+  };
+  Ds::Vector<Vertex> mVertices;
+  Ds::Vector<HalfEdge> mHalfEdges;
+  Ds::Vector<Face> mFaces;
+
+  uint32_t AddVertex(uint32_t point);
+  uint32_t AddHalfEdge(uint32_t vertex, uint32_t face);
+  uint32_t AddFace(uint32_t halfEdge);
+  // The face points are collected in the given scratch vector so finding a
+  // plane doesn't allocate.
+  HullPlane<T> FacePlane(
+    uint32_t face,
+    const Ds::Vector<Vector3>& points,
+    Ds::Vector<Vector3>* facePoints) const;
+  Vector3 FaceCenter(uint32_t face, const Ds::Vector<Vector3>& points) const;
+  void FaceSupport(
+    uint32_t face,
+    const Ds::Vector<Vector3>& points,
+    uint32_t support[3]) const;
+};
+
+constexpr uint32_t nInvalidIndex = (uint32_t)-1;
+
+template<typename T>
+uint32_t HalfEdgeMesh<T>::AddVertex(uint32_t point) {
+  mVertices.Push({point, nInvalidIndex});
+  return (uint32_t)mVertices.Size() - 1;
+}
+
+template<typename T>
+uint32_t HalfEdgeMesh<T>::AddHalfEdge(uint32_t vertex, uint32_t face) {
+  mHalfEdges.Push(
+    {vertex, nInvalidIndex, nInvalidIndex, nInvalidIndex, face});
+  return (uint32_t)mHalfEdges.Size() - 1;
+}
+
+template<typename T>
+uint32_t HalfEdgeMesh<T>::AddFace(uint32_t halfEdge) {
+  mFaces.Push({halfEdge, false, {}, {}, {}});
+  return (uint32_t)mFaces.Size() - 1;
+}
+
+template<typename T>
+HullPlane<T> HalfEdgeMesh<T>::FacePlane(
+  uint32_t face,
+  const Ds::Vector<Vector3>& points,
+  Ds::Vector<Vector3>* facePoints) const {
+  facePoints->Clear();
+  uint32_t firstEdge = mFaces[face].mHalfEdge;
+  uint32_t currentEdge = firstEdge;
+  do {
+    facePoints->Push(points[mVertices[mHalfEdges[currentEdge].mVertex].mPoint]);
+    currentEdge = mHalfEdges[currentEdge].mNext;
+  } while (currentEdge != firstEdge);
+  return HullPlane<T>::Newell(*facePoints);
+}
+
+template<typename T>
+typename HalfEdgeMesh<T>::Vector3 HalfEdgeMesh<T>::FaceCenter(
+  uint32_t face, const Ds::Vector<Vector3>& points) const {
+  Vector3 center = {0, 0, 0};
+  int count = 0;
+  uint32_t firstEdge = mFaces[face].mHalfEdge;
+  uint32_t currentEdge = firstEdge;
+  do {
+    center += points[mVertices[mHalfEdges[currentEdge].mVertex].mPoint];
+    ++count;
+    currentEdge = mHalfEdges[currentEdge].mNext;
+  } while (currentEdge != firstEdge);
+  return center / (T)count;
+}
+
+template<typename T>
+void HalfEdgeMesh<T>::FaceSupport(
+  uint32_t face, const Ds::Vector<Vector3>& points, uint32_t support[3]) const {
+  // Colinear vertices make some fan triangles degenerate, so the largest one
+  // is used.
+  auto point = [&](uint32_t edge) {
+    return mVertices[mHalfEdges[edge].mVertex].mPoint;
+  };
+  uint32_t firstEdge = mFaces[face].mHalfEdge;
+  const Vector3& origin = points[point(firstEdge)];
+  T maxAreaSq = (T)-1;
+  uint32_t currentEdge = mHalfEdges[firstEdge].mNext;
+  uint32_t nextEdge = mHalfEdges[currentEdge].mNext;
+  while (nextEdge != firstEdge) {
+    Vector3 normal = Math::Cross(
+      points[point(currentEdge)] - origin, points[point(nextEdge)] - origin);
+    T areaSq = Math::MagnitudeSq(normal);
+    if (areaSq > maxAreaSq) {
+      maxAreaSq = areaSq;
+      support[0] = point(firstEdge);
+      support[1] = point(currentEdge);
+      support[2] = point(nextEdge);
+    }
+    currentEdge = nextEdge;
+    nextEdge = mHalfEdges[nextEdge].mNext;
+  }
+}
+
+// The extreme points are organised like so: x, y, z, -x, -y, -z.
+template<typename T>
+void FindExtremePoints(
+  const Ds::Vector<Math::Vector<T, 3>>& points, size_t extremes[6]) {
+  for (int i = 0; i < 6; ++i) {
+    extremes[i] = 0;
+  }
+  for (size_t p = 1; p < points.Size(); ++p) {
+    const Math::Vector<T, 3>& point = points[p];
+    for (int i = 0; i < 3; ++i) {
+      if (point[i] > points[extremes[i]][i]) {
+        extremes[i] = p;
+      }
+      if (point[i] < points[extremes[i + 3]][i]) {
+        extremes[i + 3] = p;
+      }
+    }
+  }
+}
+
+// The layout of a hull file. The header is followed by the build stats, the
+// points, and then each of the trace and face arrays in the order their counts
+// are listed.
+constexpr uint32_t nHullMagic = 0x4c554856; // "VHUL"
+constexpr uint32_t nHullVersion = 6;
+constexpr const char* nHullExtension = ".vhull";
+
+struct HullHeader {
+  uint32_t mMagic;
+  uint32_t mVersion;
+  uint64_t mKey;
+  // The size of the scalar type the points and epsilon are stored in.
+  uint32_t mScalarSize;
+  uint32_t mDimension;
+  double mEpsilon;
+  double mApproximationError;
+  uint32_t mEdgeIdCount;
+  uint32_t mInitialVertices[4];
+  uint32_t mPointCount;
+  uint32_t mStepCount;
+  uint32_t mNewEdgeCount;
+  uint32_t mRenameCount;
+  uint32_t mCoveredEdgeCount;
+  uint32_t mColinearMergeCount;
+  uint32_t mMergedEdgeCount;
+  uint32_t mRemovedPointCount;
+  uint32_t mFaceCount;
+  uint32_t mFaceVertexCount;
+};
+
+template<typename T>
+void WriteArray(std::ofstream& file, const Ds::Vector<T>& array) {
+  file.write((const char*)array.CData(), array.Size() * sizeof(T));
+}
+
+template<typename T>
+bool ReadArray(const char** current, const char* end, Ds::Vector<T>* array) {
+  size_t size = array->Size() * sizeof(T);
+  if ((size_t)(end - *current) < size) {
+    return false;
+  }
+  std::memcpy(array->Data(), *current, size);
+  *current += size;
+  return true;
+}
+
+// Whether every index stored in a hull refers to an element of the hull. The
+// trace is replayed by indexing with these, so a corrupt hull file must not
+// get past Read.
+template<typename T>
+bool IndicesInRange(const ConvexHull<T>& hull) {
+  using Hull = ConvexHull<T>;
+  const uint32_t pointCount = (uint32_t)hull.mPoints.Size();
+  const uint32_t edgeIdCount = hull.mEdgeIdCount;
+  if (hull.mDimension < 1 || hull.mDimension > 3) {
+    return false;
+  }
+  for (uint32_t i = 0; i <= hull.mDimension; ++i) {
+    if (hull.mInitialVertices[i] >= pointCount) {
+      return false;
+    }
+  }
+
+  // The ends of every step must grow with the steps and stay in their array.
+  typename Hull::Step start = {0, 0, 0, 0, 0, 0, 0};
+  auto validEnd = [](uint32_t end, uint32_t startEnd, size_t size) {
+    return startEnd <= end && end <= size;
+  };
+  for (const typename Hull::Step& step: hull.mSteps) {
+    if (
+      step.mPoint >= pointCount ||
+      !validEnd(step.mNewEdgesEnd, start.mNewEdgesEnd, hull.mNewEdges.Size()) ||
+      !validEnd(step.mRenamesEnd, start.mRenamesEnd, hull.mRenames.Size()) ||
+      !validEnd(
+        step.mCoveredEdgesEnd,
+        start.mCoveredEdgesEnd,
+        hull.mCoveredEdges.Size()) ||
+      !validEnd(
+        step.mColinearMergesEnd,
+        start.mColinearMergesEnd,
+        hull.mColinearMerges.Size()) ||
+      !validEnd(
+        step.mMergedEdgesEnd,
+        start.mMergedEdgesEnd,
+        hull.mMergedEdges.Size()) ||
+      !validEnd(
+        step.mRemovedPointsEnd,
+        start.mRemovedPointsEnd,
+        hull.mRemovedPoints.Size())) {
+      return false;
+    }
+    start = step;
+  }
+
+  auto validTraceEdge = [&](const typename Hull::TraceEdge& edge) {
+    return edge.mId < edgeIdCount && edge.mPoint < pointCount &&
+      edge.mTwinPoint < pointCount;
+  };
+  for (const typename Hull::TraceEdge& edge: hull.mNewEdges) {
+    if (!validTraceEdge(edge)) {
+      return false;
+    }
+  }
+  for (const typename Hull::Rename& rename: hull.mRenames) {
+    if (rename.mFrom >= edgeIdCount || rename.mTo >= edgeIdCount) {
+      return false;
+    }
+  }
+  for (const typename Hull::ColinearMerge& merge: hull.mColinearMerges) {
+    for (int i = 0; i < 2; ++i) {
+      if (
+        merge.mDissolved[i] >= edgeIdCount ||
+        !validTraceEdge(merge.mExpanded[i])) {
+        return false;
+      }
+    }
+  }
+  for (uint32_t edge: hull.mCoveredEdges) {
+    if (edge >= edgeIdCount) {
+      return false;
+    }
+  }
+  for (uint32_t edge: hull.mMergedEdges) {
+    if (edge >= edgeIdCount) {
+      return false;
+    }
+  }
+  for (uint32_t point: hull.mRemovedPoints) {
+    if (point >= pointCount) {
+      return false;
+    }
+  }
+
+  // The face loops must use up exactly the face vertices.
+  uint64_t faceVertexCount = 0;
+  for (uint32_t faceSize: hull.mFaceSizes) {
+    if (faceSize < 2) {
+      return false;
+    }
+    faceVertexCount += faceSize;
+  }
+  if (faceVertexCount != hull.mFaceVertices.Size()) {
+    return false;
+  }
+  for (uint32_t point: hull.mFaceVertices) {
+    if (point >= pointCount) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename T>
+struct CacheEntry {
+  uint64_t mKey;
+  ConvexHull<T> mHull;
+};
+template<typename T>
+Ds::List<CacheEntry<T>> nCache;
+
+// Planar and colinear inputs have no polyhedron to build. Their hull is a
+// single face. Planar points are projected into the plane through the three
+// seed points and their boundary is found with a monotone chain, which keeps
+// the face ccw about Cross(b - a, c - a) for seeds a, b, and c. Colinear
+// points only need the two points furthest along their line.
+template<typename T>
+void BuildFlatHull(ConvexHull<T>* hull, const uint32_t* seeds, int seedCount) {
+  using Vector2 = Math::Vector<T, 2>;
+  using Vector3 = Math::Vector<T, 3>;
+  const Ds::Vector<Vector3>& points = hull->mPoints;
+  const Vector3& origin = points[seeds[0]];
+  Vector3 u = Math::Normalize(points[seeds[1]] - origin);
+  hull->mDimension = (uint32_t)seedCount - 1;
+  hull->mEdgeIdCount = 0;
+  for (int i = 0; i < 4; ++i) {
+    hull->mInitialVertices[i] = i < seedCount ? seeds[i] : nInvalidIndex;
+  }
+
+  if (seedCount == 2) {
+    uint32_t first = seeds[0];
+    uint32_t last = seeds[0];
+    T firstT = (T)0;
+    T lastT = (T)0;
+    for (uint32_t p = 0; p < points.Size(); ++p) {
+      T t = Math::Dot(points[p] - origin, u);
+      if (t < firstT) {
+        firstT = t;
+        first = p;
+      }
+      if (t > lastT) {
+        lastT = t;
+        last = p;
+      }
+    }
+    hull->mFaceSizes.Push(2);
+    hull->mFaceVertices.Push(first);
+    hull->mFaceVertices.Push(last);
+    return;
+  }
+
+  Vector3 normal = Math::Normalize(
+    Math::Cross(points[seeds[1]] - origin, points[seeds[2]] - origin));
+  Vector3 v = Math::Cross(normal, u);
+  Ds::Vector<Vector2> projected;
+  Ds::Vector<uint32_t> order;
+  for (uint32_t p = 0; p < points.Size(); ++p) {
+    Vector3 offset = points[p] - origin;
+    projected.Push({Math::Dot(offset, u), Math::Dot(offset, v)});
+    order.Push(p);
+  }
+  std::sort(
+    order.Data(), order.Data() + order.Size(), [&](uint32_t a, uint32_t b) {
+      if (projected[a][0] != projected[b][0]) {
+        return projected[a][0] < projected[b][0];
+      }
+      return projected[a][1] < projected[b][1];
+    });
+
+  // The lower chain is built from left to right and the upper chain from
+  // right to left. Points that don't make a strict left turn are dropped, so
+  // colinear boundary points are left out of the face.
+  Ds::Vector<uint32_t> loop;
+  auto leftTurn = [&](uint32_t next) -> bool {
+    const Vector2& a = projected[loop[loop.Size() - 2]];
+    const Vector2& b = projected[loop.Top()];
+    return Predicates::Orient2d(a, b, projected[next]) > 0.0;
+  };
+  for (size_t i = 0; i < order.Size(); ++i) {
+    while (loop.Size() >= 2 && !leftTurn(order[i])) {
+      loop.Pop();
+    }
+    loop.Push(order[i]);
+  }
+  const size_t lowerSize = loop.Size() + 1;
+  for (size_t i = order.Size() - 1; i-- > 0;) {
+    while (loop.Size() >= lowerSize && !leftTurn(order[i])) {
+      loop.Pop();
+    }
+    loop.Push(order[i]);
+  }
+  // The upper chain ends where the lower chain started.
+  loop.Pop();
+  hull->mFaceSizes.Push((uint32_t)loop.Size());
+  for (uint32_t point: loop) {
+    hull->mFaceVertices.Push(point);
+  }
+}
+
+} // namespace
+
+template<typename T>
+VResult<ConvexHull<T>> ConvexHull<T>::Build(
+  const Ds::Vector<Vector3>& points, const Options& options) {
+  using Mesh = HalfEdgeMesh<T>;
+  using HalfEdge = typename Mesh::HalfEdge;
+  using Conflict = typename Mesh::Conflict;
+  using Plane = HullPlane<T>;
+  if (points.Empty()) {
+    return Result("The points do not form a hull.");
+  }
+  if (options.mMaxVertices != 0 && options.mMaxVertices < 4) {
+    return Result("A hull needs a budget of at least 4 vertices.");
+  }
+  ConvexHull result;
+  Stats& stats = result.mStats;
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point lapStart = Clock::now();
+  auto lap = [&](typename Stats::Phase phase) {
+    Clock::time_point now = Clock::now();
+    stats.mPhaseTimes[phase] +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - lapStart)
+        .count();
+    lapStart = now;
+  };
+  const T epsilon = Epsilon(points);
+  result.mEpsilon = epsilon;
+  result.mApproximationError = (T)0;
+
+  // We only use unique points to define the hull. Equivalent points can
+  // potentially be added to the hull multiple times, resulting in a degenerate
+  // face. This is caused by a point lying outside of an average plane defined
+  // by a face containing an equivalent point.
+  Ds::Vector<uint32_t> uniqueIndices;
+  Ds::Vector<Vector3>& uniquePoints = result.mPoints;
+  for (const Vector3& point: points) {
+    uint32_t uniqueIndex = (uint32_t)uniquePoints.Size();
+    for (uint32_t u = 0; u < uniquePoints.Size(); ++u) {
+      if (NearlyEqual(point, uniquePoints[u], epsilon)) {
+        uniqueIndex = u;
+        break;
+      }
+    }
+    if (uniqueIndex == uniquePoints.Size()) {
+      uniquePoints.Push(point);
+    }
+    uniqueIndices.Push(uniqueIndex);
+  }
+  size_t extremePoints[6];
+  FindExtremePoints(points, extremePoints);
+
+  // Cases where extreme points collapse or we don't get a polyhedron need to
+  // be handled before we construct a polyhedron. We choose the first four
+  // extreme points we find to create a polyhedron.
+  Mesh hull;
+  Ds::Vector<typename Mesh::Vertex>& vertexList = hull.mVertices;
+  Ds::Vector<HalfEdge>& edgeList = hull.mHalfEdges;
+  Ds::Vector<typename Mesh::Face>& faceList = hull.mFaces;
+  auto position = [&](uint32_t vertex) -> const Vector3& {
+    return uniquePoints[vertexList[vertex].mPoint];
+  };
+  Ds::Vector<uint32_t> verts;
+  auto trySeed = [&](uint32_t newIndex) {
+    const Vector3& newPoint = uniquePoints[newIndex];
+    if (verts.Size() == 1) {
+      if (!NearlyEqual(newPoint, position(verts[0]), epsilon)) {
+        verts.Push(hull.AddVertex(newIndex));
+      }
+    }
+    else if (verts.Size() == 2) {
+      T distSq =
+        LineDistanceSq(position(verts[0]), position(verts[1]), newPoint);
+      if (!NearlyEqual(distSq, (T)0, epsilon)) {
+        verts.Push(hull.AddVertex(newIndex));
+      }
+    }
+    else if (verts.Size() == 3) {
+      Plane plane = Plane::Points(
+        position(verts[0]), position(verts[1]), position(verts[2]));
+      T pointDist = plane.Distance(newPoint);
+      if (!NearlyEqual(pointDist, (T)0, epsilon)) {
+        // The fourth vertex must lie behind the first face, so every face
+        // winds ccw when seen from outside and its Newell plane faces out.
+        // The winding comes from an exact orientation so it can't disagree
+        // with the side the point was found on.
+        verts.Push(hull.AddVertex(newIndex));
+        double orientation = Predicates::Orient3d(
+          position(verts[0]),
+          position(verts[1]),
+          position(verts[2]),
+          newPoint);
+        if (orientation > 0.0) {
+          verts.Swap(1, 2);
+        }
+      }
+    }
+  };
+  verts.Push(hull.AddVertex(uniqueIndices[extremePoints[0]]));
+  for (size_t i = 1; i < 6; ++i) {
+    trySeed(uniqueIndices[extremePoints[i]]);
+  }
+
+  // The extreme points can all lie on a plane or a line when the rest of the
+  // points don't, so every point is considered before the input is called
+  // flat. The furthest point is used each time so a thin seed triangle can't
+  // tilt the plane the remaining points are tested against.
+  if (verts.Size() == 2 || verts.Size() == 3) {
+    uint32_t furthest = vertexList[verts[0]].mPoint;
+    T furthestDistSq = (T)0;
+    for (uint32_t p = 0; p < uniquePoints.Size(); ++p) {
+      T distSq = LineDistanceSq(
+        position(verts[0]), position(verts[1]), uniquePoints[p]);
+      if (distSq > furthestDistSq) {
+        furthest = p;
+        furthestDistSq = distSq;
+      }
+    }
+    if (verts.Size() == 2) {
+      trySeed(furthest);
+    }
+    else {
+      T seedDistSq = LineDistanceSq(
+        position(verts[0]), position(verts[1]), position(verts[2]));
+      if (furthestDistSq > seedDistSq) {
+        vertexList[verts[2]].mPoint = furthest;
+      }
+    }
+  }
+  if (verts.Size() == 3) {
+    Plane plane = Plane::Points(
+      position(verts[0]), position(verts[1]), position(verts[2]));
+    uint32_t furthest = vertexList[verts[0]].mPoint;
+    T furthestDist = (T)0;
+    for (uint32_t p = 0; p < uniquePoints.Size(); ++p) {
+      T dist = Math::Abs(plane.Distance(uniquePoints[p]));
+      if (dist > furthestDist) {
+        furthest = p;
+        furthestDist = dist;
+      }
+    }
+    trySeed(furthest);
+  }
+  if (verts.Size() < 2) {
+    return Result("The points do not form a hull.");
+  }
+  if (verts.Size() < 4) {
+    uint32_t seeds[3];
+    for (uint32_t i = 0; i < verts.Size(); ++i) {
+      seeds[i] = vertexList[verts[i]].mPoint;
+    }
+    BuildFlatHull(&result, seeds, (int)verts.Size());
+    stats.mFacesCreated = 1;
+    lap(Stats::Setup);
+    return result;
+  }
+  result.mDimension = 3;
+
+  // Create the initial half edge structure representing the polyhedron.
+  const uint32_t end = nInvalidIndex;
+  uint32_t faces[4] = {
+    hull.AddFace(end), hull.AddFace(end), hull.AddFace(end), hull.AddFace(end)};
+  uint32_t edges[12] = {
+    hull.AddHalfEdge(verts[0], faces[0]),
+    hull.AddHalfEdge(verts[1], faces[0]),
+    hull.AddHalfEdge(verts[2], faces[0]),
+    hull.AddHalfEdge(verts[1], faces[1]),
+    hull.AddHalfEdge(verts[0], faces[1]),
+    hull.AddHalfEdge(verts[3], faces[1]),
+    hull.AddHalfEdge(verts[2], faces[2]),
+    hull.AddHalfEdge(verts[1], faces[2]),
+    hull.AddHalfEdge(verts[3], faces[2]),
+    hull.AddHalfEdge(verts[0], faces[3]),
+    hull.AddHalfEdge(verts[2], faces[3]),
+    hull.AddHalfEdge(verts[3], faces[3])};
+
+  edgeList[edges[0]].mTwin = edges[3];
+  edgeList[edges[1]].mTwin = edges[6];
+  edgeList[edges[2]].mTwin = edges[9];
+  edgeList[edges[3]].mTwin = edges[0];
+  edgeList[edges[4]].mTwin = edges[11];
+  edgeList[edges[5]].mTwin = edges[7];
+  edgeList[edges[6]].mTwin = edges[1];
+  edgeList[edges[7]].mTwin = edges[5];
+  edgeList[edges[8]].mTwin = edges[10];
+  edgeList[edges[9]].mTwin = edges[2];
+  edgeList[edges[10]].mTwin = edges[8];
+  edgeList[edges[11]].mTwin = edges[4];
+
+  for (int f = 0; f < 4; ++f) {
+    for (int e = 0; e < 3; ++e) {
+      uint32_t edge = edges[f * 3 + e];
+      uint32_t nextEdge = edges[f * 3 + (e + 1) % 3];
+      edgeList[edge].mNext = nextEdge;
+      edgeList[nextEdge].mPrev = edge;
+    }
+    faceList[faces[f]].mHalfEdge = edges[f * 3];
+  }
+
+  vertexList[verts[0]].mHalfEdge = edges[0];
+  vertexList[verts[1]].mHalfEdge = edges[3];
+  vertexList[verts[2]].mHalfEdge = edges[6];
+  vertexList[verts[3]].mHalfEdge = edges[11];
+
+  // Half edges are never freed, so their indices serve as their trace ids.
+  auto next = [&](uint32_t edge) -> uint32_t {
+    return edgeList[edge].mNext;
+  };
+  auto prev = [&](uint32_t edge) -> uint32_t {
+    return edgeList[edge].mPrev;
+  };
+  auto twin = [&](uint32_t edge) -> uint32_t {
+    return edgeList[edge].mTwin;
+  };
+  auto traceEdge = [&](uint32_t edge) -> TraceEdge {
+    return {
+      edge,
+      vertexList[edgeList[edge].mVertex].mPoint,
+      vertexList[edgeList[twin(edge)].mVertex].mPoint};
+  };
+  for (int i = 0; i < 4; ++i) {
+    result.mInitialVertices[i] = vertexList[verts[i]].mPoint;
+  }
+  // Edges 0, 1, 2, 5, 8, and 11 cover every edge of the tetrahedron once.
+  const int initialEdgeOrder[12] = {0, 1, 2, 5, 8, 11, 3, 4, 6, 7, 9, 10};
+  for (int i: initialEdgeOrder) {
+    result.mNewEdges.Push(traceEdge(edges[i]));
+  }
+
+  // Every face owns a conflict list. Each conflict list stores the indices of
+  // points that do not lie in the hull. A face's plane is found once when the
+  // face is complete and is used for all of its conflict tests. Its support
+  // triangle is found at the same time.
+  Ds::Vector<Vector3> facePoints;
+  auto completeFace = [&](uint32_t face) {
+    ++stats.mPlaneEvaluations;
+    faceList[face].mPlane = hull.FacePlane(face, uniquePoints, &facePoints);
+    hull.FaceSupport(face, uniquePoints, faceList[face].mSupport);
+  };
+  for (uint32_t face: faces) {
+    completeFace(face);
+  }
+
+  // A point lies in front of a face when it is further than epsilon from the
+  // face's plane and the exact orientation of the face's support triangle
+  // agrees. Conflict assignment and the horizon share this test, so a face is
+  // visible to an eye point exactly when the point could be its conflict.
+  // Merged faces are only nearly planar and the exact sign keeps a rounded
+  // plane distance from making a face visible to a point behind it.
+  auto inFront = [&](uint32_t face, uint32_t point, T* dist) {
+    *dist = faceList[face].mPlane.Distance(uniquePoints[point]);
+    if (*dist <= epsilon) {
+      return false;
+    }
+    const uint32_t* support = faceList[face].mSupport;
+    return Predicates::Orient3d(
+             uniquePoints[support[0]],
+             uniquePoints[support[1]],
+             uniquePoints[support[2]],
+             uniquePoints[point]) > 0.0;
+  };
+
+  // Find the plane each point is closest to and give the point to that plane's
+  // conflict list. Dead faces among the candidates are skipped.
+  auto assignConflictPoint =
+    [&](uint32_t point, const Ds::Vector<uint32_t>& candidates) -> bool {
+    T minDist = std::numeric_limits<T>::max();
+    uint32_t bestFace = nInvalidIndex;
+    for (uint32_t face: candidates) {
+      if (faceList[face].mDead) {
+        continue;
+      }
+      T dist;
+      if (inFront(face, point, &dist) && dist < minDist) {
+        minDist = dist;
+        bestFace = face;
+      }
+    }
+    if (bestFace != nInvalidIndex) {
+      faceList[bestFace].mConflicts.Push({point, minDist});
+      return true;
+    }
+    return false;
+  };
+  Ds::Vector<uint32_t> conflictFaces;
+  for (uint32_t face: faces) {
+    conflictFaces.Push(face);
+  }
+  for (uint32_t p = 0; p < uniquePoints.Size(); ++p) {
+    if (!assignConflictPoint(p, conflictFaces)) {
+      result.mRemovedPoints.Push(p);
+    }
+  }
+
+  // Each step records where its entries end once it is complete.
+  auto endStep = [&result](uint32_t point) {
+    result.mSteps.Push(
+      {point,
+       (uint32_t)result.mNewEdges.Size(),
+       (uint32_t)result.mRenames.Size(),
+       (uint32_t)result.mCoveredEdges.Size(),
+       (uint32_t)result.mColinearMerges.Size(),
+       (uint32_t)result.mMergedEdges.Size(),
+       (uint32_t)result.mRemovedPoints.Size()});
+  };
+  endStep(result.mInitialVertices[0]);
+
+  // Only the living faces with conflicting points need to be considered.
+  // Faces that died or lost their points are dropped from conflictFaces in
+  // place and the new faces that received points are appended.
+  Ds::Vector<uint32_t> newFaces;
+  auto updateConflictFaces = [&]() {
+    size_t kept = 0;
+    for (size_t f = 0; f < conflictFaces.Size(); ++f) {
+      const typename Mesh::Face& face = faceList[conflictFaces[f]];
+      if (!face.mDead && !face.mConflicts.Empty()) {
+        conflictFaces[kept++] = conflictFaces[f];
+      }
+    }
+    conflictFaces.Resize(kept, 0);
+    for (uint32_t newFace: newFaces) {
+      const typename Mesh::Face& face = faceList[newFace];
+      if (!face.mDead && !face.mConflicts.Empty()) {
+        conflictFaces.Push(newFace);
+      }
+    }
+  };
+  updateConflictFaces();
+  lap(Stats::Setup);
+
+  // Every iteration uses this scratch memory. It is cleared at the start of
+  // an iteration and keeps its capacity, so iterations only allocate once
+  // they need more room than any earlier iteration did.
+  Ds::Vector<uint32_t> horizon;
+  Ds::Vector<uint32_t> visitedFaces;
+  Ds::Vector<uint32_t> interiorVerts;
+  Ds::Vector<uint32_t> newHorizonVerts;
+  Ds::Vector<uint32_t> oldHorizonBorder;
+  Ds::Vector<uint32_t> conflictPoints;
+  Ds::Vector<uint32_t> deadEdges;
+  Ds::Vector<uint32_t> possibleMerges;
+  Ds::Vector<uint32_t> mergePositions;
+  Ds::Vector<uint32_t> mergedEdges;
+  uint32_t newIndex;
+  uint32_t vertexCount = 4;
+
+  // Treating the best point as an eye looking towards the current hull, this
+  // finds the edges that form the horizon around the hull. The horizon edges
+  // are the edges that border the faces to be deleted and they are stored in a
+  // ccw order.
+  std::function<void(uint32_t)> visitEdge = [&](uint32_t edge) {
+    uint32_t face = edgeList[edge].mFace;
+    if (visitedFaces.Contains(face)) {
+      return;
+    }
+    visitedFaces.Push(face);
+    uint32_t currentEdge = edge;
+    do {
+      uint32_t twinEdge = twin(currentEdge);
+      T dist;
+      if (!inFront(edgeList[twinEdge].mFace, newIndex, &dist)) {
+        horizon.Push(twinEdge);
+      }
+      else {
+        visitEdge(twinEdge);
+      }
+    } while ((currentEdge = next(currentEdge)) != edge);
+  };
+
+  // The convex hull has been obtained once all conflicting points are handled.
+  while (!conflictFaces.Empty()) {
+    horizon.Clear();
+    visitedFaces.Clear();
+    newHorizonVerts.Clear();
+    oldHorizonBorder.Clear();
+    conflictPoints.Clear();
+    deadEdges.Clear();
+    possibleMerges.Clear();
+    mergedEdges.Clear();
+    newFaces.Clear();
+
+    // For all points in the conflict lists, find the point with maximum
+    // distance from its respective plane. This point will be added next.
+    T maxDist = -std::numeric_limits<T>::max();
+    uint32_t bestFace = nInvalidIndex;
+    int bestConflictIdx = -1;
+    for (uint32_t face: conflictFaces) {
+      const Ds::Vector<Conflict>& conflicts = faceList[face].mConflicts;
+      for (uint32_t c = 0; c < conflicts.Size(); ++c) {
+        if (conflicts[c].mDistance > maxDist) {
+          maxDist = conflicts[c].mDistance;
+          bestFace = face;
+          bestConflictIdx = (int)c;
+        }
+      }
+    }
+
+    // The points are added from furthest to closest, so the distance of the
+    // next point bounds the error of the hull if the build ends here.
+    bool budgetSpent =
+      options.mMaxVertices != 0 && vertexCount >= options.mMaxVertices;
+    if (budgetSpent || maxDist <= options.mTolerance) {
+      // The points that are left out become removed points of the last step.
+      result.mApproximationError = maxDist;
+      for (uint32_t face: conflictFaces) {
+        for (const Conflict& conflict: faceList[face].mConflicts) {
+          result.mRemovedPoints.Push(conflict.mPoint);
+        }
+      }
+      result.mSteps.Top().mRemovedPointsEnd =
+        (uint32_t)result.mRemovedPoints.Size();
+      lap(Stats::Horizon);
+      break;
+    }
+    ++vertexCount;
+    ++stats.mIterations;
+
+    // The point is being added to the hull and is hence no longer a conflict.
+    Ds::Vector<Conflict>& bestConflicts = faceList[bestFace].mConflicts;
+    newIndex = bestConflicts[bestConflictIdx].mPoint;
+    bestConflicts.LazyRemove(bestConflictIdx);
+    visitEdge(faceList[bestFace].mHalfEdge);
+    result.mRemovedPoints.Push(newIndex);
+
+    // The vertices of the visible faces that aren't on the horizon are covered
+    // by the new faces and leave the hull.
+    interiorVerts.Clear();
+    for (uint32_t face: visitedFaces) {
+      uint32_t firstEdge = faceList[face].mHalfEdge;
+      uint32_t currentEdge = firstEdge;
+      do {
+        interiorVerts.Push(edgeList[currentEdge].mVertex);
+        currentEdge = next(currentEdge);
+      } while (currentEdge != firstEdge);
+    }
+    for (uint32_t v = 0; v < interiorVerts.Size(); ++v) {
+      uint32_t vertex = interiorVerts[v];
+      bool counted = false;
+      for (uint32_t u = 0; u < v && !counted; ++u) {
+        counted = interiorVerts[u] == vertex;
+      }
+      for (uint32_t h = 0; h < horizon.Size() && !counted; ++h) {
+        counted = edgeList[horizon[h]].mVertex == vertex;
+      }
+      if (!counted) {
+        --vertexCount;
+      }
+    }
+    uint32_t horizonSize = (uint32_t)horizon.Size();
+    uint32_t lastBucket = (uint32_t)Stats::smHorizonBuckets - 1;
+    ++stats.mHorizonSizes[Math::Min(horizonSize, lastBucket)];
+    stats.mMaxHorizonSize = Math::Max(stats.mMaxHorizonSize, horizonSize);
+    lap(Stats::Horizon);
+
+    // We create a new vertex for each horizon vertex because it makes deleting
+    // no longer needed elements a bit easier.
+    for (uint32_t hEdge: horizon) {
+      newHorizonVerts.Push(
+        hull.AddVertex(vertexList[edgeList[hEdge].mVertex].mPoint));
+    }
+
+    // The half edges bordering the horizon will be replaced with new half
+    // edges and the trace records which half edge replaced which.
+    for (uint32_t hEdge: horizon) {
+      oldHorizonBorder.Push(twin(hEdge));
+    }
+
+    // Imagine drawing a line from the best point to each of the vertices that
+    // lie on the horizon. The new faces formed by these lines and the horizon
+    // edges are created here.
+    uint32_t newVertex = hull.AddVertex(newIndex);
+    for (uint32_t i = 0; i < horizon.Size(); ++i) {
+      uint32_t hEdge = horizon[i];
+      uint32_t hEdgeNext = horizon[(i + 1) % horizon.Size()];
+      uint32_t nhVert = newHorizonVerts[i];
+      uint32_t nhVertNext = newHorizonVerts[(i + 1) % horizon.Size()];
+
+      uint32_t newFace = hull.AddFace(end);
+      uint32_t newEdges[3] = {
+        hull.AddHalfEdge(newVertex, newFace),
+        hull.AddHalfEdge(nhVert, newFace),
+        hull.AddHalfEdge(nhVertNext, newFace)};
+      faceList[newFace].mHalfEdge = newEdges[0];
+      vertexList[newVertex].mHalfEdge = newEdges[0];
+      vertexList[nhVert].mHalfEdge = newEdges[1];
+
+      // Ensure that all edges referencing the old horizon vertex reference the
+      // new horizon vertex.
+      uint32_t currentOldVertEdge = hEdge;
+      do {
+        edgeList[currentOldVertEdge].mVertex = nhVert;
+        currentOldVertEdge = twin(prev(currentOldVertEdge));
+      } while (currentOldVertEdge != twin(hEdgeNext));
+
+      // Link together all edge edge references and create a conflict list
+      // representing the new face.
+      edgeList[hEdgeNext].mTwin = newEdges[1];
+      edgeList[newEdges[1]].mTwin = hEdgeNext;
+      for (int e = 0; e < 3; ++e) {
+        edgeList[newEdges[e]].mNext = newEdges[(e + 1) % 3];
+        edgeList[newEdges[(e + 1) % 3]].mPrev = newEdges[e];
+      }
+      completeFace(newFace);
+      newFaces.Push(newFace);
+    }
+
+    // Set the twin references of all edges going to and from the new vertex.
+    for (uint32_t i = 0; i < horizon.Size(); ++i) {
+      uint32_t hEdge = horizon[i];
+      uint32_t hEdgeNext = horizon[(i + 1) % horizon.Size()];
+      edgeList[next(twin(hEdge))].mTwin = prev(twin(hEdgeNext));
+      edgeList[prev(twin(hEdgeNext))].mTwin = next(twin(hEdge));
+    }
+
+    // Only the edges attached to the new vertex are new.
+    for (uint32_t hEdge: horizon) {
+      result.mNewEdges.Push(traceEdge(next(twin(hEdge))));
+      result.mNewEdges.Push(traceEdge(twin(next(twin(hEdge)))));
+    }
+    for (uint32_t i = 0; i < horizon.Size(); ++i) {
+      result.mRenames.Push({oldHorizonBorder[i], twin(horizon[i])});
+    }
+
+    // Any time we delete a face, we save the points in its conflict list in
+    // order to reassign them to the new faces at the end of the iteration.
+    // New faces don't receive points until then, so theirs are empty.
+    auto tryRemoveFaceConflictList = [&](uint32_t face) {
+      Ds::Vector<Conflict>& conflicts = faceList[face].mConflicts;
+      for (const Conflict& conflict: conflicts) {
+        conflictPoints.Push(conflict.mPoint);
+      }
+      conflicts.Clear();
+    };
+
+    // Kill the faces that were covered by the new faces along with their edges
+    // and conflict lists.
+    for (uint32_t face: visitedFaces) {
+      uint32_t firstEdge = faceList[face].mHalfEdge;
+      uint32_t currentEdge = firstEdge;
+      do {
+        deadEdges.Push(currentEdge);
+        currentEdge = next(currentEdge);
+      } while (currentEdge != firstEdge);
+      tryRemoveFaceConflictList(face);
+      faceList[face].mDead = true;
+    }
+    for (uint32_t edge: deadEdges) {
+      result.mCoveredEdges.Push(edge);
+    }
+    lap(Stats::NewFaces);
+
+    // We now need to merge faces that are coplanar. We only need to check
+    // whether faces adjacent across new edges are coplanar. We collect all of
+    // those edges here. The position of every edge in possibleMerges is kept
+    // so an edge can be found and removed in constant time. Edges that aren't
+    // possible merges have an invalid position.
+    mergePositions.Resize(edgeList.Size(), nInvalidIndex);
+    auto pushPossibleMerge = [&](uint32_t edge) {
+      mergePositions[edge] = (uint32_t)possibleMerges.Size();
+      possibleMerges.Push(edge);
+    };
+    uint32_t currentEdge = vertexList[newVertex].mHalfEdge;
+    do {
+      pushPossibleMerge(next(currentEdge));
+      pushPossibleMerge(next(next(currentEdge)));
+      currentEdge = twin(prev(currentEdge));
+    } while (currentEdge != vertexList[newVertex].mHalfEdge);
+    auto tryRemovePossibleMerge = [&](uint32_t edge) {
+      uint32_t position = mergePositions[edge];
+      if (position == nInvalidIndex) {
+        return;
+      }
+      uint32_t lastEdge = possibleMerges.Top();
+      possibleMerges[position] = lastEdge;
+      mergePositions[lastEdge] = position;
+      possibleMerges.Pop();
+      mergePositions[edge] = nInvalidIndex;
+    };
+
+    // As we merge faces, topological errors can arise. If only two edges emerge
+    // from a vertex, we have a topological error. Every vertex needs to have 3
+    // edges to make it be a part of the volume. We stop walking around the
+    // vertex as soon as we know it doesn't have exactly two edges.
+    auto ensureValidVertex = [&](uint32_t vertex) {
+      uint32_t vertexEdges[2];
+      vertexEdges[0] = vertexList[vertex].mHalfEdge;
+      vertexEdges[1] = next(twin(vertexEdges[0]));
+      if (
+        vertexEdges[1] == vertexEdges[0] ||
+        next(twin(vertexEdges[1])) != vertexEdges[0]) {
+        return;
+      }
+      uint32_t firstVertexEdge = vertexEdges[0];
+      result.mRemovedPoints.Push(vertexList[vertex].mPoint);
+      --vertexCount;
+
+      // How we deal with this topological error is determined by the number of
+      // vertices the two adjacent faces have.
+      int faceEdgeCounts[2] = {0, 0};
+      for (int ve = 0; ve < 2; ++ve) {
+        uint32_t currentFaceEdge = vertexEdges[ve];
+        do {
+          ++faceEdgeCounts[ve];
+          currentFaceEdge = next(currentFaceEdge);
+        } while (currentFaceEdge != vertexEdges[ve]);
+      }
+
+      uint32_t edges[2] = {prev(firstVertexEdge), firstVertexEdge};
+      uint32_t edgeTwins[2] = {twin(edges[1]), twin(edges[0])};
+      if (faceEdgeCounts[0] == 3 || faceEdgeCounts[1] == 3) {
+        ++stats.mTriangleRemovals;
+        // When one of the faces is a triangle, we must remove the vertex and
+        // all edges going to and from it. First we update all references to
+        // edges that will be removed.
+        edgeList[prev(edges[0])].mNext = next(edgeTwins[1]);
+        edgeList[next(edgeTwins[1])].mPrev = prev(edges[0]);
+        edgeList[next(edges[1])].mPrev = prev(edgeTwins[0]);
+        edgeList[prev(edgeTwins[0])].mNext = next(edges[1]);
+
+        // Create the new face used to reprsent the merged faces.
+        uint32_t newFace = hull.AddFace(next(edges[1]));
+        completeFace(newFace);
+        newFaces.Push(newFace);
+
+        // Ensure all edges within the merged faces reference the new face and
+        // that remaining vertices reference existing half edges.
+        uint32_t currentEdge = next(edges[1]);
+        do {
+          edgeList[currentEdge].mFace = newFace;
+          currentEdge = next(currentEdge);
+        } while (currentEdge != next(edges[1]));
+        vertexList[edgeList[edges[0]].mVertex].mHalfEdge =
+          next(prev(edges[0]));
+        vertexList[edgeList[edgeTwins[0]].mVertex].mHalfEdge =
+          next(prev(edgeTwins[0]));
+
+        // Remove no longer necessary elements.
+        uint32_t edgeFace = edgeList[edges[0]].mFace;
+        uint32_t edgeTwinFace = edgeList[edgeTwins[0]].mFace;
+        tryRemoveFaceConflictList(edgeFace);
+        tryRemoveFaceConflictList(edgeTwinFace);
+        tryRemovePossibleMerge(edges[0]);
+        tryRemovePossibleMerge(edges[1]);
+        tryRemovePossibleMerge(edgeTwins[0]);
+        tryRemovePossibleMerge(edgeTwins[1]);
+        faceList[edgeFace].mDead = true;
+        faceList[edgeTwinFace].mDead = true;
+        mergedEdges.Push(edges[0]);
+        mergedEdges.Push(edges[1]);
+        mergedEdges.Push(edgeTwins[0]);
+        mergedEdges.Push(edgeTwins[1]);
+      }
+      else {
+        ++stats.mColinearMerges;
+        // When neither of the adjacent faces are triangles, the vertex edges
+        // are colinear and must be merged into a single edge. We repurpose one
+        // set of half edges to represent the merged edge and update  references
+        // to the other two half edges that will be removed.
+        edgeList[edges[0]].mNext = next(edges[1]);
+        edgeList[edges[0]].mTwin = edgeTwins[0];
+        edgeList[next(edges[1])].mPrev = edges[0];
+        edgeList[edgeTwins[0]].mNext = next(edgeTwins[1]);
+        edgeList[edgeTwins[0]].mTwin = edges[0];
+        edgeList[next(edgeTwins[1])].mPrev = edgeTwins[0];
+
+        // Ensure that the faces reference existing edges.
+        faceList[edgeList[edges[0]].mFace].mHalfEdge = edges[0];
+        faceList[edgeList[edgeTwins[0]].mFace].mHalfEdge = edgeTwins[0];
+
+        // Remove no longer necessary elements.
+        tryRemovePossibleMerge(edges[1]);
+        tryRemovePossibleMerge(edgeTwins[1]);
+        mergedEdges.Push(edges[1]);
+        mergedEdges.Push(edgeTwins[1]);
+        result.mColinearMerges.Push(
+          {{edges[1], edgeTwins[1]},
+           {traceEdge(edges[0]), traceEdge(edgeTwins[0])}});
+      }
+    };
+
+    // Coplanar faces are merged using one of the edges shared between them.
+    auto mergeFaces = [&](uint32_t edge) {
+      ++stats.mCoplanarMerges;
+      // Link the edges going away and towards the deleted edge.
+      uint32_t edgeTwin = twin(edge);
+      edgeList[prev(edge)].mNext = next(edgeTwin);
+      edgeList[next(edge)].mPrev = prev(edgeTwin);
+      edgeList[prev(edgeTwin)].mNext = next(edge);
+      edgeList[next(edgeTwin)].mPrev = prev(edge);
+
+      // Create the new face and ensure vertices reference a remaining half edge
+      // and that all remaining edges reference the new face.
+      uint32_t newFace = hull.AddFace(next(edge));
+      completeFace(newFace);
+      newFaces.Push(newFace);
+      vertexList[edgeList[edge].mVertex].mHalfEdge = next(edgeTwin);
+      vertexList[edgeList[edgeTwin].mVertex].mHalfEdge = next(edge);
+      uint32_t currentEdge = next(edge);
+      do {
+        edgeList[currentEdge].mFace = newFace;
+        currentEdge = next(currentEdge);
+      } while (currentEdge != next(edge));
+
+      // Ensure that the two vertices that lost an edge an edge are still valid
+      // and erase no long necessary elements.
+      ensureValidVertex(edgeList[edge].mVertex);
+      ensureValidVertex(edgeList[edgeTwin].mVertex);
+      tryRemoveFaceConflictList(edgeList[edge].mFace);
+      tryRemoveFaceConflictList(edgeList[edgeTwin].mFace);
+      tryRemovePossibleMerge(edge);
+      tryRemovePossibleMerge(edgeTwin);
+      faceList[edgeList[edge].mFace].mDead = true;
+      faceList[edgeList[edgeTwin].mFace].mDead = true;
+      mergedEdges.Push(edge);
+      mergedEdges.Push(edgeTwin);
+    };
+
+    // Check whether a merge should be performed over all possible merges.
+    // Faces are merged when the angle between their normals lies within the
+    // angle epsilon and the edge between them is convex. The angle is tested
+    // first so the face centers are only found for nearly coplanar faces.
+    const T angleEpsilon = (T)0.015;
+    while (!possibleMerges.Empty()) {
+      uint32_t edge = possibleMerges.Top();
+      uint32_t face = edgeList[edge].mFace;
+      uint32_t twinFace = edgeList[twin(edge)].mFace;
+      const Plane& facePlane = faceList[face].mPlane;
+      const Plane& twinFacePlane = faceList[twinFace].mPlane;
+      T angle = Angle(facePlane.Normal(), twinFacePlane.Normal());
+      bool mergeable = NearlyEqual(angle, (T)0, angleEpsilon);
+
+      // If a face's halfspace contains the center of the adjacent face and vice
+      // versa, the edge is considered convex.
+      if (mergeable) {
+        Vector3 faceCenter = hull.FaceCenter(face, uniquePoints);
+        Vector3 twinFaceCenter = hull.FaceCenter(twinFace, uniquePoints);
+        mergeable = facePlane.HalfSpaceContains(twinFaceCenter, epsilon) &&
+          twinFacePlane.HalfSpaceContains(faceCenter, epsilon);
+      }
+      if (mergeable) {
+        mergeFaces(edge);
+      }
+      else {
+        tryRemovePossibleMerge(edge);
+      }
+    }
+    for (uint32_t edge: mergedEdges) {
+      result.mMergedEdges.Push(edge);
+    }
+    lap(Stats::Merges);
+
+    // Distribute orphaned conflict points to the new faces that survived the
+    // merges. We ignore any faces that have no conflict points.
+    stats.mConflictReassignments += conflictPoints.Size();
+    for (uint32_t point: conflictPoints) {
+      if (!assignConflictPoint(point, newFaces)) {
+        result.mRemovedPoints.Push(point);
+      }
+    }
+    updateConflictFaces();
+    endStep(newIndex);
+    lap(Stats::Reassignment);
+  }
+
+  result.mEdgeIdCount = (uint32_t)edgeList.Size();
+  stats.mFacesCreated = (uint32_t)faceList.Size();
+  for (uint32_t face = 0; face < faceList.Size(); ++face) {
+    if (faceList[face].mDead) {
+      ++stats.mFacesDeleted;
+      continue;
+    }
+    uint32_t faceSize = 0;
+    uint32_t firstEdge = faceList[face].mHalfEdge;
+    uint32_t currentEdge = firstEdge;
+    do {
+      result.mFaceVertices.Push(
+        vertexList[edgeList[currentEdge].mVertex].mPoint);
+      ++faceSize;
+      currentEdge = next(currentEdge);
+    } while (currentEdge != firstEdge);
+    result.mFaceSizes.Push(faceSize);
+  }
+  lap(Stats::Output);
+  return result;
+}
+
+template<typename T>
+VResult<const ConvexHull<T>*> ConvexHull<T>::Acquire(
+  const Ds::Vector<Vector3>& points,
+  const std::string& cacheDirectory,
+  const Options& options) {
+  const uint64_t key = Key(points, options);
+  for (auto it = nCache<T>.cbegin(); it != nCache<T>.cend(); ++it) {
+    if (it->mKey == key) {
+      return &it->mHull;
+    }
+  }
+
+  std::string filename;
+  if (!cacheDirectory.empty()) {
+    char keyString[17];
+    snprintf(keyString, sizeof(keyString), "%016llx", (unsigned long long)key);
+    filename = cacheDirectory + "/" + keyString + nHullExtension;
+    VResult<ConvexHull> readResult = Read(filename, key);
+    if (readResult.Success()) {
+      auto it = nCache<T>.PushBack({key, std::move(readResult.mValue)});
+      return &it->mHull;
+    }
+  }
+
+  VResult<ConvexHull> buildResult = Build(points, options);
+  if (!buildResult.Success()) {
+    return Result(buildResult.mError);
+  }
+  // Failing to write the hull only means it is built again on the next run.
+  if (!filename.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+    buildResult.mValue.Write(filename, key);
+  }
+  auto it = nCache<T>.PushBack({key, std::move(buildResult.mValue)});
+  return &it->mHull;
+}
+
+template<typename T>
+uint64_t ConvexHull<T>::Key(
+  const Ds::Vector<Vector3>& points, const Options& options) {
+  uint64_t key = HashValue(nHullVersion, nHashSeed);
+  key = HashValue((uint32_t)sizeof(T), key);
+  key = HashValue(options.mMaxVertices, key);
+  key = HashValue((double)options.mTolerance, key);
+  key = HashBytes(points.CData(), points.Size() * sizeof(Vector3), key);
+  return HashValue(Epsilon(points), key);
+}
+
+template<typename T>
+T ConvexHull<T>::Epsilon(const Ds::Vector<Vector3>& points) {
+  if (points.Empty()) {
+    return (T)0;
+  }
+  // Find an epsilon that accounts for the span of the point collection.
+  // nEpsilon is tuned for floats, so wider scalar types scale it down by how
+  // much more precise they are.
+  using namespace Math;
+  size_t eps[6];
+  FindExtremePoints(points, eps);
+  Vector3 maxes = {
+    Max(Abs(points[eps[0]][0]), Abs(points[eps[3]][0])),
+    Max(Abs(points[eps[1]][1]), Abs(points[eps[4]][1])),
+    Max(Abs(points[eps[2]][2]), Abs(points[eps[5]][2]))};
+  const T precision = (T)nEpsilon *
+    (std::numeric_limits<T>::epsilon() / std::numeric_limits<float>::epsilon());
+  return (T)3 * (maxes[0] + maxes[1] + maxes[2]) * precision;
+}
+
+template<typename T>
+Result ConvexHull<T>::Write(const std::string& filename, uint64_t key) const {
+  HullHeader header = {
+    nHullMagic,
+    nHullVersion,
+    key,
+    (uint32_t)sizeof(T),
+    mDimension,
+    (double)mEpsilon,
+    (double)mApproximationError,
+    mEdgeIdCount,
+    {mInitialVertices[0],
+     mInitialVertices[1],
+     mInitialVertices[2],
+     mInitialVertices[3]},
+    (uint32_t)mPoints.Size(),
+    (uint32_t)mSteps.Size(),
+    (uint32_t)mNewEdges.Size(),
+    (uint32_t)mRenames.Size(),
+    (uint32_t)mCoveredEdges.Size(),
+    (uint32_t)mColinearMerges.Size(),
+    (uint32_t)mMergedEdges.Size(),
+    (uint32_t)mRemovedPoints.Size(),
+    (uint32_t)mFaceSizes.Size(),
+    (uint32_t)mFaceVertices.Size()};
+
+  std::string tempFilename = filename + ".tmp";
+  std::ofstream file(tempFilename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Result("Failed to open \"" + tempFilename + "\".");
+  }
+  file.write((const char*)&header, sizeof(HullHeader));
+  file.write((const char*)&mStats, sizeof(Stats));
+  WriteArray(file, mPoints);
+  WriteArray(file, mSteps);
+  WriteArray(file, mNewEdges);
+  WriteArray(file, mRenames);
+  WriteArray(file, mCoveredEdges);
+  WriteArray(file, mColinearMerges);
+  WriteArray(file, mMergedEdges);
+  WriteArray(file, mRemovedPoints);
+  WriteArray(file, mFaceSizes);
+  WriteArray(file, mFaceVertices);
+  file.close();
+  if (file.fail()) {
+    return Result("Failed to write \"" + tempFilename + "\".");
+  }
+  std::error_code error;
+  std::filesystem::rename(tempFilename, filename, error);
+  if (error) {
+    return Result("Failed to replace \"" + filename + "\".");
+  }
+  return Result();
+}
+
+template<typename T>
+VResult<ConvexHull<T>> ConvexHull<T>::Read(
+  const std::string& filename, uint64_t key) {
+  VResult<MappedFile> fileResult = MappedFile::Init(filename);
+  if (!fileResult.Success()) {
+    return Result(fileResult.mError);
+  }
+  const MappedFile& file = fileResult.mValue;
+  const char* current = file.Data();
+  const char* end = file.Data() + file.Size();
+  HullHeader header;
+  if (file.Size() < sizeof(HullHeader) + sizeof(Stats)) {
+    return Result("\"" + filename + "\" is not a hull.");
+  }
+  std::memcpy(&header, current, sizeof(HullHeader));
+  current += sizeof(HullHeader);
+  if (header.mMagic != nHullMagic) {
+    return Result("\"" + filename + "\" is not a hull.");
+  }
+  if (
+    header.mVersion != nHullVersion || header.mKey != key ||
+    header.mScalarSize != sizeof(T)) {
+    return Result("\"" + filename + "\" is outdated.");
+  }
+
+  // The counts must describe the file exactly before anything is allocated
+  // for them.
+  uint64_t expectedSize = sizeof(HullHeader) + sizeof(Stats) +
+    (uint64_t)header.mPointCount * sizeof(Vector3) +
+    (uint64_t)header.mStepCount * sizeof(Step) +
+    (uint64_t)header.mNewEdgeCount * sizeof(TraceEdge) +
+    (uint64_t)header.mRenameCount * sizeof(Rename) +
+    (uint64_t)header.mCoveredEdgeCount * sizeof(uint32_t) +
+    (uint64_t)header.mColinearMergeCount * sizeof(ColinearMerge) +
+    (uint64_t)header.mMergedEdgeCount * sizeof(uint32_t) +
+    (uint64_t)header.mRemovedPointCount * sizeof(uint32_t) +
+    (uint64_t)header.mFaceCount * sizeof(uint32_t) +
+    (uint64_t)header.mFaceVertexCount * sizeof(uint32_t);
+  if (expectedSize != file.Size()) {
+    return Result("\"" + filename + "\" is corrupt.");
+  }
+
+  ConvexHull hull;
+  std::memcpy(&hull.mStats, current, sizeof(Stats));
+  current += sizeof(Stats);
+  hull.mDimension = header.mDimension;
+  hull.mEpsilon = (T)header.mEpsilon;
+  hull.mApproximationError = (T)header.mApproximationError;
+  hull.mEdgeIdCount = header.mEdgeIdCount;
+  for (int i = 0; i < 4; ++i) {
+    hull.mInitialVertices[i] = header.mInitialVertices[i];
+  }
+  hull.mPoints.Resize(header.mPointCount);
+  hull.mSteps.Resize(header.mStepCount);
+  hull.mNewEdges.Resize(header.mNewEdgeCount);
+  hull.mRenames.Resize(header.mRenameCount);
+  hull.mCoveredEdges.Resize(header.mCoveredEdgeCount);
+  hull.mColinearMerges.Resize(header.mColinearMergeCount);
+  hull.mMergedEdges.Resize(header.mMergedEdgeCount);
+  hull.mRemovedPoints.Resize(header.mRemovedPointCount);
+  hull.mFaceSizes.Resize(header.mFaceCount);
+  hull.mFaceVertices.Resize(header.mFaceVertexCount);
+  bool complete = ReadArray(&current, end, &hull.mPoints) &&
+    ReadArray(&current, end, &hull.mSteps) &&
+    ReadArray(&current, end, &hull.mNewEdges) &&
+    ReadArray(&current, end, &hull.mRenames) &&
+    ReadArray(&current, end, &hull.mCoveredEdges) &&
+    ReadArray(&current, end, &hull.mColinearMerges) &&
+    ReadArray(&current, end, &hull.mMergedEdges) &&
+    ReadArray(&current, end, &hull.mRemovedPoints) &&
+    ReadArray(&current, end, &hull.mFaceSizes) &&
+    ReadArray(&current, end, &hull.mFaceVertices);
+  if (!complete || current != end || !IndicesInRange(hull)) {
+    return Result("\"" + filename + "\" is corrupt.");
+  }
+  return hull;
+}
+
+template<typename T>
+typename ConvexHull<T>::Step ConvexHull<T>::StepStart(size_t step) const {
+  if (step == 0) {
+    return {0, 0, 0, 0, 0, 0, 0};
+  }
+  return mSteps[step - 1];
+}
+
+template struct ConvexHull<float>;
+template struct ConvexHull<double>;
@@ -0,0 +1,159 @@
+#ifndef ConvexHull_h
+#define ConvexHull_h
+
+#include <Result.h>
+#include <ds/Vector.h>
+#include <math/Vector.h>
+#include <stdint.h>
+#include <string>
+
+// The convex hull of a point set built with quick hull. Along with the final
+// faces, it keeps a trace of every step the construction took so the
+// construction can be replayed without running it again. The scalar type is
+// chosen at compile time and only float and double are instantiated.
+template<typename T>
+struct ConvexHull {
+  using Vector3 = Math::Vector<T, 3>;
+
+  // Half edges are identified by the order they were created in. An id stays
+  // attached to a half edge for its whole lifetime, even when the half edge is
+  // repurposed by a merge.
+  struct TraceEdge {
+    uint32_t mId;
+    // The point the half edge leaves from and the point its twin leaves from.
+    uint32_t mPoint;
+    uint32_t mTwinPoint;
+  };
+
+  // A half edge that was replaced by a new half edge on the same edge.
+  struct Rename {
+    uint32_t mFrom;
+    uint32_t mTo;
+  };
+
+  // Two colinear edges that were merged into one. The dissolved half edges are
+  // removed and the expanded half edges span both edges afterwards.
+  struct ColinearMerge {
+    uint32_t mDissolved[2];
+    TraceEdge mExpanded[2];
+  };
+
+  // Steps store one past their last entry in each of the trace arrays. A
+  // step's entries begin where the previous step's entries end. The first
+  // step creates the initial tetrahedron. Its new edges list one half edge of
+  // every edge before the remaining half edges and its removed points are the
+  // points that lie within the tetrahedron. Every other step adds mPoint. The
+  // last step of an approximate hull also removes the points left out of it.
+  struct Step {
+    uint32_t mPoint;
+    uint32_t mNewEdgesEnd;
+    uint32_t mRenamesEnd;
+    uint32_t mCoveredEdgesEnd;
+    uint32_t mColinearMergesEnd;
+    uint32_t mMergedEdgesEnd;
+    uint32_t mRemovedPointsEnd;
+  };
+
+  // Limits that end a build early with an approximate hull for level of
+  // detail. A limit of zero is ignored, so zeroed options give the exact hull.
+  struct Options {
+    // The build stops before the hull would exceed this many vertices. Any
+    // nonzero budget must allow for the initial tetrahedron.
+    uint32_t mMaxVertices;
+    // The build stops once no point lies further than this outside the hull.
+    T mTolerance;
+  };
+
+  // Counters and phase times a build gathers as it goes. They cost a few
+  // increments and clock reads per iteration, so they are always gathered.
+  // Hull files keep the stats of the build that produced them.
+  struct Stats {
+    enum Phase {
+      // Deduplication, seeding, and the initial conflict assignment.
+      Setup,
+      // Choosing the furthest point and walking the faces it can see.
+      Horizon,
+      // Creating the faces around the new point and killing the seen faces.
+      NewFaces,
+      Merges,
+      Reassignment,
+      // Extracting the final faces.
+      Output,
+      PhaseCount,
+    };
+    static constexpr const char* smPhaseNames[PhaseCount] = {
+      "Setup", "Horizon", "NewFaces", "Merges", "Reassignment", "Output"};
+    static constexpr int smHorizonBuckets = 16;
+
+    // The number of points that were added after the initial tetrahedron.
+    uint32_t mIterations;
+    // Bucket i counts the iterations whose horizon had i edges. The last
+    // bucket also counts every larger horizon.
+    uint32_t mHorizonSizes[smHorizonBuckets];
+    uint32_t mMaxHorizonSize;
+    // Merges and triangle removals replace faces too, so these include the
+    // faces they create and delete.
+    uint32_t mFacesCreated;
+    uint32_t mFacesDeleted;
+    uint64_t mPlaneEvaluations;
+    uint32_t mCoplanarMerges;
+    // The two ways a vertex left with two edges by a merge is repaired.
+    uint32_t mTriangleRemovals;
+    uint32_t mColinearMerges;
+    // Conflict points taken from deleted faces and assigned again.
+    uint64_t mConflictReassignments;
+    // Nanoseconds spent in each phase.
+    int64_t mPhaseTimes[PhaseCount];
+  };
+
+  static VResult<ConvexHull> Build(
+    const Ds::Vector<Vector3>& points, const Options& options = {0, 0});
+  // Provides the hull of a point set without building it when a hull of the
+  // same points was already built during this run or was written to the
+  // cache directory by an earlier run. An empty directory only uses memory.
+  static VResult<const ConvexHull*> Acquire(
+    const Ds::Vector<Vector3>& points,
+    const std::string& cacheDirectory,
+    const Options& options = {0, 0});
+  static uint64_t Key(
+    const Ds::Vector<Vector3>& points, const Options& options = {0, 0});
+  static T Epsilon(const Ds::Vector<Vector3>& points);
+
+  Result Write(const std::string& filename, uint64_t key) const;
+  static VResult<ConvexHull> Read(const std::string& filename, uint64_t key);
+
+  // The first step's entries begin at the start of every array.
+  Step StepStart(size_t step) const;
+
+  // The input points without duplicates. All point indices refer to these.
+  Ds::Vector<Vector3> mPoints;
+  // 3 for a polyhedron. Planar input has a dimension of 2 and colinear input
+  // a dimension of 1. These flat hulls are a single face without a trace and
+  // only the initial vertices that seeded the face are valid.
+  uint32_t mDimension;
+  T mEpsilon;
+  // How far the furthest point left out of an approximate hull lies outside
+  // of it. Zero for an exact hull.
+  T mApproximationError;
+  uint32_t mEdgeIdCount;
+  uint32_t mInitialVertices[4];
+  Ds::Vector<Step> mSteps;
+  Ds::Vector<TraceEdge> mNewEdges;
+  Ds::Vector<Rename> mRenames;
+  Ds::Vector<uint32_t> mCoveredEdges;
+  Ds::Vector<ColinearMerge> mColinearMerges;
+  Ds::Vector<uint32_t> mMergedEdges;
+  Ds::Vector<uint32_t> mRemovedPoints;
+
+  // The final faces as loops of point indices. Each face's loop follows the
+  // previous face's loop in mFaceVertices.
+  Ds::Vector<uint32_t> mFaceSizes;
+  Ds::Vector<uint32_t> mFaceVertices;
+
+  Stats mStats = {};
+};
+
+extern template struct ConvexHull<float>;
+extern template struct ConvexHull<double>;
+
+#endif
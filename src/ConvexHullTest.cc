@@ -0,0 +1,136 @@
+#include <cmath>
+#include <cstdio>
+
+#include "ConvexHull.h"
+
+// Checks that hulls of nearly coplanar float input, like the rotated point
+// clouds of the video, still merge their faces and keep every point inside.
+// The exit code is the number of failed checks.
+
+namespace {
+
+int nFailures = 0;
+
+void Check(bool condition, const char* description) {
+  if (!condition) {
+    std::printf("failed: %s\n", description);
+    ++nFailures;
+  }
+}
+
+using Vector3 = ConvexHull<float>::Vector3;
+
+// Rotates the points about the z axis. The rotation's sine and cosine are
+// rounded, so points that shared a plane before only nearly share one after.
+void Rotate(Ds::Vector<Vector3>* points, float angle) {
+  float sin = std::sin(angle);
+  float cos = std::cos(angle);
+  for (Vector3& point: *points) {
+    point = {
+      cos * point[0] - sin * point[1],
+      sin * point[0] + cos * point[1],
+      point[2]};
+  }
+}
+
+// The largest distance of any point in front of a face's plane. The plane of
+// each face goes through the face's first vertex and has the normal of the
+// face's largest fan triangle.
+float MaxOutsideDistance(const ConvexHull<float>& hull) {
+  float maxDist = 0;
+  size_t offset = 0;
+  for (uint32_t faceSize: hull.mFaceSizes) {
+    const Vector3& origin = hull.mPoints[hull.mFaceVertices[offset]];
+    Vector3 normal = {0, 0, 0};
+    for (uint32_t i = 1; i + 1 < faceSize; ++i) {
+      const Vector3& b = hull.mPoints[hull.mFaceVertices[offset + i]];
+      const Vector3& c = hull.mPoints[hull.mFaceVertices[offset + i + 1]];
+      Vector3 fanNormal = Math::Cross(b - origin, c - origin);
+      if (Math::MagnitudeSq(fanNormal) > Math::MagnitudeSq(normal)) {
+        normal = fanNormal;
+      }
+    }
+    normal = Math::Normalize(normal);
+    for (const Vector3& point: hull.mPoints) {
+      maxDist = Math::Max(maxDist, Math::Dot(normal, point - origin));
+    }
+    offset += faceSize;
+  }
+  return maxDist;
+}
+
+// The vertex, edge, and face counts of a closed polyhedron satisfy
+// V - E + F = 2.
+bool EulerCharacteristicHolds(const ConvexHull<float>& hull) {
+  Ds::Vector<bool> used;
+  used.Resize(hull.mPoints.Size(), false);
+  size_t vertexCount = 0;
+  for (uint32_t point: hull.mFaceVertices) {
+    if (!used[point]) {
+      used[point] = true;
+      ++vertexCount;
+    }
+  }
+  size_t edgeCount = hull.mFaceVertices.Size() / 2;
+  size_t faceCount = hull.mFaceSizes.Size();
+  return vertexCount + faceCount == edgeCount + 2;
+}
+
+void TestRotatedCylinder() {
+  // Two caps of 12 points each, so the exact hull has 12 sides and 2 caps.
+  Ds::Vector<Vector3> points;
+  for (int i = 0; i < 12; ++i) {
+    float theta = 6.2831853f * (float)i / 12.0f;
+    points.Push({1.5f, 2.0f * std::sin(theta), 2.0f * std::cos(theta)});
+    points.Push({-1.5f, 2.0f * std::sin(theta), 2.0f * std::cos(theta)});
+  }
+  Rotate(&points, 3.1415927f / 2.0f);
+  VResult<ConvexHull<float>> result = ConvexHull<float>::Build(points);
+  Check(result.Success(), "The rotated cylinder is hulled");
+  if (!result.Success()) {
+    return;
+  }
+  const ConvexHull<float>& hull = result.mValue;
+  Check(hull.mFaceSizes.Size() == 14, "The cylinder's caps are merged");
+  Check(EulerCharacteristicHolds(hull), "The cylinder's hull is closed");
+  Check(
+    MaxOutsideDistance(hull) <= hull.mEpsilon,
+    "No point lies outside of the cylinder's hull");
+}
+
+void TestRotatedGrid() {
+  // Every face of the cube holds a grid of points, so the exact hull is the
+  // cube's 6 faces.
+  Ds::Vector<Vector3> points;
+  for (int x = 0; x < 5; ++x) {
+    for (int y = 0; y < 5; ++y) {
+      for (int z = 0; z < 5; ++z) {
+        points.Push(
+          {(float)x * 0.5f - 1, (float)y * 0.5f - 1, (float)z * 0.5f});
+      }
+    }
+  }
+  Rotate(&points, 0.3f);
+  VResult<ConvexHull<float>> result = ConvexHull<float>::Build(points);
+  Check(result.Success(), "The rotated grid is hulled");
+  if (!result.Success()) {
+    return;
+  }
+  const ConvexHull<float>& hull = result.mValue;
+  Check(hull.mFaceSizes.Size() == 6, "The grid's faces are merged");
+  Check(EulerCharacteristicHolds(hull), "The grid's hull is closed");
+  Check(
+    MaxOutsideDistance(hull) <= hull.mEpsilon,
+    "No point lies outside of the grid's hull");
+}
+
+} // namespace
+
+int main() {
+  TestRotatedCylinder();
+  TestRotatedGrid();
+  if (nFailures == 0) {
+    std::printf("All checks passed.\n");
+  }
+  return nFailures;
+}
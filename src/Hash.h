@@ -0,0 +1,24 @@
+#ifndef Hash_h
+#define Hash_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 64 bit FNV-1a. It is used to detect when the inputs of cached or baked data
+// have changed, so it only needs to be fast and well distributed.
+constexpr uint64_t nHashSeed = 0xcbf29ce484222325;
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t hash) {
+  const unsigned char* bytes = (const unsigned char*)data;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+template<typename T>
+uint64_t HashValue(const T& value, uint64_t hash) {
+  return HashBytes(&value, sizeof(T), hash);
+}
+
+#endif
@@ -0,0 +1,170 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "HullMesh.h"
+#include "HullPlane.h"
+
+namespace {
+
+constexpr uint32_t nInvalidIndex = (uint32_t)-1;
+
+// The layout of a mesh file. The header is followed by the positions, the
+// normals, and the indices. Every array is made of 4 byte values, so each one
+// stays aligned within a mapping of the file.
+constexpr uint32_t nMeshMagic = 0x48534d56; // "VMSH"
+constexpr uint32_t nMeshVersion = 1;
+
+struct MeshHeader {
+  uint32_t mMagic;
+  uint32_t mVersion;
+  uint32_t mVertexCount;
+  uint32_t mTriangleCount;
+};
+
+Result ReplaceFile(
+  const std::string& tempFilename, const std::string& filename) {
+  std::error_code error;
+  std::filesystem::rename(tempFilename, filename, error);
+  if (error) {
+    return Result("Failed to replace \"" + filename + "\".");
+  }
+  return Result();
+}
+
+} // namespace
+
+template<typename T>
+HullMesh HullMesh::Create(const ConvexHull<T>& hull) {
+  HullMesh mesh;
+  Ds::Vector<uint32_t> pointVertices;
+  pointVertices.Resize(hull.mPoints.Size(), nInvalidIndex);
+  Ds::Vector<Math::Vector<T, 3>> facePoints;
+  size_t offset = 0;
+  for (uint32_t faceSize: hull.mFaceSizes) {
+    const uint32_t* face = hull.mFaceVertices.CData() + offset;
+    offset += faceSize;
+    // The loop of a colinear hull is a single edge and has no triangles.
+    if (faceSize < 3) {
+      continue;
+    }
+
+    facePoints.Clear();
+    for (uint32_t i = 0; i < faceSize; ++i) {
+      uint32_t point = face[i];
+      facePoints.Push(hull.mPoints[point]);
+      if (pointVertices[point] == nInvalidIndex) {
+        const Math::Vector<T, 3>& position = hull.mPoints[point];
+        pointVertices[point] = (uint32_t)mesh.mPositions.Size();
+        mesh.mPositions.Push(
+          {(float)position[0], (float)position[1], (float)position[2]});
+      }
+    }
+    HullPlane<T> plane = HullPlane<T>::Newell(facePoints);
+    const Math::Vector<T, 3>& normal = plane.Normal();
+    Vec3 faceNormal = {(float)normal[0], (float)normal[1], (float)normal[2]};
+    for (uint32_t i = 1; i + 1 < faceSize; ++i) {
+      mesh.mIndices.Push(pointVertices[face[0]]);
+      mesh.mIndices.Push(pointVertices[face[i]]);
+      mesh.mIndices.Push(pointVertices[face[i + 1]]);
+      mesh.mNormals.Push(faceNormal);
+    }
+  }
+  return mesh;
+}
+
+Result HullMesh::WriteObj(const std::string& filename) const {
+  std::string tempFilename = filename + ".tmp";
+  std::ofstream file(tempFilename, std::ios::trunc);
+  if (!file.is_open()) {
+    return Result("Failed to open \"" + tempFilename + "\".");
+  }
+  // Nine significant digits are enough for every float to read back exactly.
+  file.precision(9);
+  for (const Vec3& position: mPositions) {
+    file << "v " << position[0] << ' ' << position[1] << ' ' << position[2]
+         << '\n';
+  }
+  for (const Vec3& normal: mNormals) {
+    file << "vn " << normal[0] << ' ' << normal[1] << ' ' << normal[2] << '\n';
+  }
+  // Obj indices start at 1.
+  for (size_t t = 0; t < mNormals.Size(); ++t) {
+    file << "f";
+    for (size_t i = 0; i < 3; ++i) {
+      file << ' ' << mIndices[t * 3 + i] + 1 << "//" << t + 1;
+    }
+    file << '\n';
+  }
+  file.close();
+  if (file.fail()) {
+    return Result("Failed to write \"" + tempFilename + "\".");
+  }
+  return ReplaceFile(tempFilename, filename);
+}
+
+Result HullMesh::Write(const std::string& filename) const {
+  MeshHeader header = {
+    nMeshMagic,
+    nMeshVersion,
+    (uint32_t)mPositions.Size(),
+    (uint32_t)mNormals.Size()};
+  std::string tempFilename = filename + ".tmp";
+  std::ofstream file(tempFilename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Result("Failed to open \"" + tempFilename + "\".");
+  }
+  file.write((const char*)&header, sizeof(MeshHeader));
+  file.write(
+    (const char*)mPositions.CData(), mPositions.Size() * sizeof(Vec3));
+  file.write((const char*)mNormals.CData(), mNormals.Size() * sizeof(Vec3));
+  file.write(
+    (const char*)mIndices.CData(), mIndices.Size() * sizeof(uint32_t));
+  file.close();
+  if (file.fail()) {
+    return Result("Failed to write \"" + tempFilename + "\".");
+  }
+  return ReplaceFile(tempFilename, filename);
+}
+
+VResult<HullMesh::View> HullMesh::Map(const std::string& filename) {
+  VResult<MappedFile> fileResult = MappedFile::Init(filename);
+  if (!fileResult.Success()) {
+    return Result(fileResult.mError);
+  }
+  View view;
+  view.mFile = std::move(fileResult.mValue);
+  const char* data = view.mFile.Data();
+  size_t size = view.mFile.Size();
+  MeshHeader header;
+  if (size < sizeof(MeshHeader)) {
+    return Result("\"" + filename + "\" is not a mesh.");
+  }
+  std::memcpy(&header, data, sizeof(MeshHeader));
+  if (header.mMagic != nMeshMagic) {
+    return Result("\"" + filename + "\" is not a mesh.");
+  }
+  if (header.mVersion != nMeshVersion) {
+    return Result("\"" + filename + "\" is outdated.");
+  }
+
+  size_t positionsSize = header.mVertexCount * sizeof(Vec3);
+  size_t normalsSize = header.mTriangleCount * sizeof(Vec3);
+  size_t indicesSize = header.mTriangleCount * 3 * sizeof(uint32_t);
+  if (
+    size != sizeof(MeshHeader) + positionsSize + normalsSize + indicesSize) {
+    return Result("\"" + filename + "\" is corrupt.");
+  }
+  const char* current = data + sizeof(MeshHeader);
+  view.mPositions = (const Vec3*)current;
+  current += positionsSize;
+  view.mNormals = (const Vec3*)current;
+  current += normalsSize;
+  view.mIndices = (const uint32_t*)current;
+  view.mVertexCount = header.mVertexCount;
+  view.mTriangleCount = header.mTriangleCount;
+  return view;
+}
+
+template HullMesh HullMesh::Create(const ConvexHull<float>& hull);
+template HullMesh HullMesh::Create(const ConvexHull<double>& hull);
@@ -0,0 +1,48 @@
+#ifndef HullMesh_h
+#define HullMesh_h
+
+#include <Result.h>
+#include <ds/Vector.h>
+#include <math/Vector.h>
+#include <stdint.h>
+#include <string>
+
+#include "ConvexHull.h"
+#include "MappedFile.h"
+
+// The final faces of a hull as a triangle mesh for tools that only consume
+// vertex and index buffers. Faces are convex, so each one is split into a fan
+// around its first vertex.
+struct HullMesh {
+  template<typename T>
+  static HullMesh Create(const ConvexHull<T>& hull);
+
+  // Writes a text obj where every triangle references its face's normal.
+  Result WriteObj(const std::string& filename) const;
+  // Writes the binary format that View maps.
+  Result Write(const std::string& filename) const;
+
+  // A binary mesh file mapped into memory. The arrays point directly into the
+  // mapping, so nothing is copied and they remain valid while the view lives.
+  struct View {
+    MappedFile mFile;
+    const Vec3* mPositions;
+    const Vec3* mNormals;
+    const uint32_t* mIndices;
+    uint32_t mVertexCount;
+    uint32_t mTriangleCount;
+  };
+  static VResult<View> Map(const std::string& filename);
+
+  // Every hull vertex appears once no matter how many faces share it.
+  Ds::Vector<Vec3> mPositions;
+  // One normal for each triangle. Triangles of the same face share a normal.
+  Ds::Vector<Vec3> mNormals;
+  // Three vertex indices for each triangle, ccw when seen from outside.
+  Ds::Vector<uint32_t> mIndices;
+};
+
+extern template HullMesh HullMesh::Create(const ConvexHull<float>& hull);
+extern template HullMesh HullMesh::Create(const ConvexHull<double>& hull);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef HullPlane_h
+#define HullPlane_h
+
+#include <ds/Vector.h>
+#include <math/Vector.h>
+
+// Math::Plane only comes in single precision, so the hull code uses its own
+// plane for the scalar type it is working in.
+template<typename T>
+struct HullPlane {
+  using Vector3 = Math::Vector<T, 3>;
+  Vector3 mNormal;
+  T mD;
+
+  // The area of the polygon is also given when area isn't null.
+  static HullPlane Newell(
+    const Ds::Vector<Vector3>& points, T* area = nullptr);
+  static HullPlane Points(const Vector3& a, const Vector3& b, const Vector3& c);
+  T Distance(const Vector3& point) const;
+  bool HalfSpaceContains(const Vector3& point, T epsilon) const;
+  const Vector3& Normal() const;
+};
+
+template<typename T>
+HullPlane<T> HullPlane<T>::Newell(
+  const Ds::Vector<Vector3>& points, T* area) {
+  Vector3 normal = {0, 0, 0};
+  Vector3 center = {0, 0, 0};
+  for (size_t i = 0; i < points.Size(); ++i) {
+    const Vector3& a = points[i];
+    const Vector3& b = points[(i + 1) % points.Size()];
+    normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+    normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+    normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+    center += a;
+  }
+  center /= (T)points.Size();
+  if (area != nullptr) {
+    *area = Math::Magnitude(normal) / (T)2;
+  }
+  normal = Math::Normalize(normal);
+  return {normal, Math::Dot(normal, center)};
+}
+
+template<typename T>
+HullPlane<T> HullPlane<T>::Points(
+  const Vector3& a, const Vector3& b, const Vector3& c) {
+  Vector3 normal = Math::Normalize(Math::Cross(b - a, c - a));
+  return {normal, Math::Dot(normal, a)};
+}
+
+template<typename T>
+T HullPlane<T>::Distance(const Vector3& point) const {
+  return Math::Dot(mNormal, point) - mD;
+}
+
+template<typename T>
+bool HullPlane<T>::HalfSpaceContains(const Vector3& point, T epsilon) const {
+  return Distance(point) <= epsilon;
+}
+
+template<typename T>
+const typename HullPlane<T>::Vector3& HullPlane<T>::Normal() const {
+  return mNormal;
+}
+
+#endif
@@ -0,0 +1,176 @@
+#include <algorithm>
+
+#include "HullQuery.h"
+
+namespace {
+
+constexpr uint32_t nInvalidIndex = (uint32_t)-1;
+
+} // namespace
+
+template<typename T>
+HullQuery<T>::HullQuery(const ConvexHull<T>& hull, uint32_t hierarchyLevels):
+  mFlat(hull.mDimension != 3), mSupportStart(0) {
+  // Hull vertices are given compact indices in the order they are found.
+  Ds::Vector<uint32_t> pointVertices;
+  pointVertices.Resize(hull.mPoints.Size(), nInvalidIndex);
+  for (uint32_t point: hull.mFaceVertices) {
+    if (pointVertices[point] == nInvalidIndex) {
+      pointVertices[point] = (uint32_t)mVertices.Size();
+      mVertices.Push(hull.mPoints[point]);
+      mVertexPoints.Push(point);
+    }
+  }
+
+  // Every edge of a polyhedron is in two faces that traverse it in opposite
+  // directions, so each face only records the vertex following each of its
+  // vertices. The single face of a flat hull records both directions.
+  auto visitEdges = [&](auto visit) {
+    size_t offset = 0;
+    for (uint32_t faceSize: hull.mFaceSizes) {
+      for (uint32_t i = 0; i < faceSize; ++i) {
+        uint32_t from = pointVertices[hull.mFaceVertices[offset + i]];
+        uint32_t to =
+          pointVertices[hull.mFaceVertices[offset + (i + 1) % faceSize]];
+        visit(from, to);
+        if (mFlat) {
+          visit(to, from);
+        }
+      }
+      offset += faceSize;
+    }
+  };
+  mAdjacencyStarts.Resize(mVertices.Size() + 1, 0);
+  visitEdges([this](uint32_t from, uint32_t) {
+    ++mAdjacencyStarts[from + 1];
+  });
+  for (size_t v = 1; v < mAdjacencyStarts.Size(); ++v) {
+    mAdjacencyStarts[v] += mAdjacencyStarts[v - 1];
+  }
+  Ds::Vector<uint32_t> cursors;
+  for (size_t v = 0; v < mVertices.Size(); ++v) {
+    cursors.Push(mAdjacencyStarts[v]);
+  }
+  mAdjacency.Resize(mAdjacencyStarts.Top(), 0);
+  visitEdges([&](uint32_t from, uint32_t to) {
+    mAdjacency[cursors[from]++] = to;
+  });
+
+  // Each coarser level is an approximate hull of the full hull's vertices, so
+  // it lies inside of the full hull and every full hull vertex lies within
+  // its approximation error of the coarse hull's planes.
+  Ds::Vector<Level> coarseLevels;
+  uint32_t budget = (uint32_t)mVertices.Size();
+  for (uint32_t l = 0; l < hierarchyLevels && !mFlat; ++l) {
+    budget /= 4;
+    if (budget < 8) {
+      break;
+    }
+    VResult<ConvexHull<T>> coarseResult =
+      ConvexHull<T>::Build(mVertices, {budget, (T)0});
+    if (!coarseResult.Success() || coarseResult.mValue.mDimension != 3) {
+      break;
+    }
+    const ConvexHull<T>& coarse = coarseResult.mValue;
+    coarseLevels.Push(CreateLevel(
+      coarse.mPoints,
+      coarse.mFaceSizes,
+      coarse.mFaceVertices,
+      coarse.mApproximationError + coarse.mEpsilon));
+  }
+  for (size_t l = coarseLevels.Size(); l-- > 0;) {
+    mLevels.Push(std::move(coarseLevels[l]));
+  }
+  mLevels.Push(
+    CreateLevel(hull.mPoints, hull.mFaceSizes, hull.mFaceVertices, (T)0));
+}
+
+template<typename T>
+typename HullQuery<T>::Level HullQuery<T>::CreateLevel(
+  const Ds::Vector<Vector3>& points,
+  const Ds::Vector<uint32_t>& faceSizes,
+  const Ds::Vector<uint32_t>& faceVertices,
+  T margin) {
+  struct AreaPlane {
+    T mArea;
+    HullPlane<T> mPlane;
+  };
+  Ds::Vector<AreaPlane> areaPlanes;
+  Ds::Vector<Vector3> facePoints;
+  size_t offset = 0;
+  for (uint32_t faceSize: faceSizes) {
+    facePoints.Clear();
+    for (uint32_t i = 0; i < faceSize; ++i) {
+      facePoints.Push(points[faceVertices[offset + i]]);
+    }
+    offset += faceSize;
+    AreaPlane areaPlane;
+    areaPlane.mPlane = HullPlane<T>::Newell(facePoints, &areaPlane.mArea);
+    areaPlanes.Push(areaPlane);
+  }
+  std::sort(
+    areaPlanes.Data(),
+    areaPlanes.Data() + areaPlanes.Size(),
+    [](const AreaPlane& a, const AreaPlane& b) {
+      return a.mArea > b.mArea;
+    });
+
+  Level level;
+  for (const AreaPlane& areaPlane: areaPlanes) {
+    level.mPlanes.Push(areaPlane.mPlane);
+  }
+  level.mMargin = margin;
+  return level;
+}
+
+template<typename T>
+uint32_t HullQuery<T>::Support(const Vector3& direction) const {
+  // A vertex without a better neighbour is the furthest vertex because the
+  // hull is convex.
+  uint32_t current = mSupportStart;
+  T currentDot = Math::Dot(mVertices[current], direction);
+  bool climbed = true;
+  while (climbed) {
+    climbed = false;
+    uint32_t end = mAdjacencyStarts[current + 1];
+    for (uint32_t a = mAdjacencyStarts[current]; a < end; ++a) {
+      uint32_t neighbour = mAdjacency[a];
+      T neighbourDot = Math::Dot(mVertices[neighbour], direction);
+      if (neighbourDot > currentDot) {
+        current = neighbour;
+        currentDot = neighbourDot;
+        climbed = true;
+        break;
+      }
+    }
+  }
+  mSupportStart = current;
+  return mVertexPoints[current];
+}
+
+template<typename T>
+bool HullQuery<T>::Contains(const Vector3& point, T tolerance) const {
+  if (mFlat) {
+    return false;
+  }
+  // A point further than a level's margin outside of any of its planes is
+  // outside of the full hull and a point inside of a level is inside of the
+  // full hull. Other points are passed on to the next finer level.
+  for (const Level& level: mLevels) {
+    bool inside = true;
+    for (const HullPlane<T>& plane: level.mPlanes) {
+      T distance = plane.Distance(point);
+      if (distance > level.mMargin + tolerance) {
+        return false;
+      }
+      inside = inside && distance <= tolerance;
+    }
+    if (inside) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template struct HullQuery<float>;
+template struct HullQuery<double>;
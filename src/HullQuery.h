@@ -0,0 +1,61 @@
+#ifndef HullQuery_h
+#define HullQuery_h
+
+#include <ds/Vector.h>
+#include <math/Vector.h>
+#include <stdint.h>
+
+#include "ConvexHull.h"
+#include "HullPlane.h"
+
+// Answers support and containment queries against a finished hull without
+// scanning all of its vertices or faces.
+template<typename T>
+struct HullQuery {
+  using Vector3 = Math::Vector<T, 3>;
+
+  // Containment first consults up to hierarchyLevels coarser hulls built from
+  // a quarter of the previous level's vertices. Most points are accepted or
+  // rejected by a coarse level and never reach the faces of the full hull.
+  HullQuery(const ConvexHull<T>& hull, uint32_t hierarchyLevels = 0);
+
+  // The index of the hull point furthest in the given direction. It is found
+  // by climbing across vertex neighbours from the vertex the previous query
+  // ended on, so queries with coherent directions take only a few steps. The
+  // cached vertex makes this unsafe to call from multiple threads at once.
+  uint32_t Support(const Vector3& direction) const;
+  // Whether a point lies within tolerance of the hull. Flat hulls contain no
+  // points.
+  bool Contains(const Vector3& point, T tolerance) const;
+
+private:
+  // The face planes of one hull in the hierarchy ordered by decreasing face
+  // area, since large faces reject the most points. Every point of the full
+  // hull lies within mMargin of all of the planes.
+  struct Level {
+    Ds::Vector<HullPlane<T>> mPlanes;
+    T mMargin;
+  };
+  static Level CreateLevel(
+    const Ds::Vector<Vector3>& points,
+    const Ds::Vector<uint32_t>& faceSizes,
+    const Ds::Vector<uint32_t>& faceVertices,
+    T margin);
+
+  bool mFlat;
+  // The hull vertices and the vertices adjacent to each of them. Vertex v's
+  // neighbours are in mAdjacency from mAdjacencyStarts[v] up to
+  // mAdjacencyStarts[v + 1].
+  Ds::Vector<Vector3> mVertices;
+  Ds::Vector<uint32_t> mVertexPoints;
+  Ds::Vector<uint32_t> mAdjacencyStarts;
+  Ds::Vector<uint32_t> mAdjacency;
+  mutable uint32_t mSupportStart;
+  // The coarsest level comes first and the full hull is last.
+  Ds::Vector<Level> mLevels;
+};
+
+extern template struct HullQuery<float>;
+extern template struct HullQuery<double>;
+
+#endif
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "ConvexHull.h"
+#include "HullMesh.h"
+#include "MappedFile.h"
+#include "ObjPoints.h"
+#include "PointCloud.h"
+#include "WorkerPool.h"
+
+// Builds the hulls of many point files without a window or the engine. Every
+// input is loaded, hulled, and exported as an obj and a binary mesh on a
+// worker pool. A table of statistics is printed once every input is done and
+// the counters and phase times of every build follow it with --stats.
+
+namespace {
+
+const char* nUsage =
+  "usage: HullTool [options] <input>...\n"
+  "Inputs ending in .obj are read as obj vertices, inputs ending in .vpc as\n"
+  "point clouds, and all others as raw float32 xyz triples. An input of -\n"
+  "reads raw float32 xyz triples from stdin.\n"
+  "  -o <directory>        Where meshes are written. Defaults to \".\".\n"
+  "  -j <count>            Worker threads. Defaults to the hardware threads.\n"
+  "  --max-vertices <n>    Stop the build before exceeding n hull vertices.\n"
+  "  --tolerance <t>       Stop the build once no point is further than t\n"
+  "                        outside the hull.\n"
+  "  --double              Build the hulls with double precision scalars\n"
+  "                        instead of float.\n"
+  "  --no-mesh             Only print statistics.\n"
+  "  --stats               Also print the counters and phase times of every\n"
+  "                        build.\n";
+
+struct Settings {
+  std::string mOutputDirectory = ".";
+  unsigned int mThreadCount = 0;
+  bool mWriteMeshes = true;
+  bool mPrintStats = false;
+  bool mDouble = false;
+  ConvexHull<float>::Options mOptions = {0, 0.0f};
+  Ds::Vector<std::string> mInputs;
+};
+
+struct Report {
+  std::string mInput;
+  std::string mError;
+  size_t mPointCount = 0;
+  size_t mVertexCount = 0;
+  size_t mFaceCount = 0;
+  double mLoadMs = 0.0;
+  double mBuildMs = 0.0;
+  double mWriteMs = 0.0;
+  // Only the stats of the scalar type that was built with are filled.
+  ConvexHull<float>::Stats mFloatStats = {};
+  ConvexHull<double>::Stats mDoubleStats = {};
+};
+
+VResult<Ds::Vector<Vec3>> ReadRawPoints(const char* data, size_t size) {
+  if (size % sizeof(Vec3) != 0) {
+    return Result("Raw points must be a whole number of xyz triples.");
+  }
+  Ds::Vector<Vec3> points;
+  points.Resize(size / sizeof(Vec3));
+  std::memcpy(points.Data(), data, size);
+  return points;
+}
+
+VResult<Ds::Vector<Vec3>> LoadPoints(const std::string& input) {
+  if (input == "-") {
+    Ds::Vector<char> data;
+    char buffer[1 << 16];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), stdin)) > 0) {
+      size_t start = data.Size();
+      data.Resize(start + read);
+      std::memcpy(data.Data() + start, buffer, read);
+    }
+    return ReadRawPoints(data.CData(), data.Size());
+  }
+
+  std::string extension = std::filesystem::path(input).extension().string();
+  if (extension == ".obj") {
+    // Files are already spread across the workers, so a single obj is not
+    // split between threads as well.
+    return LoadObjPoints(input, 1);
+  }
+  if (extension == PointCloud::smExtension) {
+    VResult<PointCloud> cloudResult = PointCloud::Init(input);
+    if (!cloudResult.Success()) {
+      return Result(cloudResult.mError);
+    }
+    const PointCloud& cloud = cloudResult.mValue;
+    return ReadRawPoints(
+      (const char*)cloud.Points(), cloud.Count() * sizeof(Vec3));
+  }
+  VResult<MappedFile> fileResult = MappedFile::Init(input);
+  if (!fileResult.Success()) {
+    return Result(fileResult.mError);
+  }
+  VResult<Ds::Vector<Vec3>> pointsResult =
+    ReadRawPoints(fileResult.mValue.Data(), fileResult.mValue.Size());
+  if (!pointsResult.Success()) {
+    return Result("\"" + input + "\": " + pointsResult.mError);
+  }
+  return pointsResult;
+}
+
+double MsSince(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::milli> duration =
+    std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+template<typename T>
+typename ConvexHull<T>::Stats* ReportStats(Report* report);
+template<>
+ConvexHull<float>::Stats* ReportStats<float>(Report* report) {
+  return &report->mFloatStats;
+}
+template<>
+ConvexHull<double>::Stats* ReportStats<double>(Report* report) {
+  return &report->mDoubleStats;
+}
+
+template<typename T>
+void BuildHull(
+  const Settings& settings, const Ds::Vector<Vec3>& points, Report* report) {
+  // Points are converted before the build is timed so both scalar types are
+  // compared on the build alone.
+  using Vector3 = typename ConvexHull<T>::Vector3;
+  Ds::Vector<Vector3> scalarPoints;
+  scalarPoints.Reserve(points.Size());
+  for (const Vec3& point: points) {
+    scalarPoints.Push({(T)point[0], (T)point[1], (T)point[2]});
+  }
+  typename ConvexHull<T>::Options options = {
+    settings.mOptions.mMaxVertices, (T)settings.mOptions.mTolerance};
+
+  auto start = std::chrono::steady_clock::now();
+  VResult<ConvexHull<T>> hullResult =
+    ConvexHull<T>::Build(scalarPoints, options);
+  report->mBuildMs = MsSince(start);
+  if (!hullResult.Success()) {
+    report->mError = hullResult.mError;
+    return;
+  }
+  const ConvexHull<T>& hull = hullResult.mValue;
+  Ds::Vector<uint32_t> vertices = hull.mFaceVertices;
+  std::sort(vertices.Data(), vertices.Data() + vertices.Size());
+  report->mVertexCount =
+    std::unique(vertices.Data(), vertices.Data() + vertices.Size()) -
+    vertices.Data();
+  report->mFaceCount = hull.mFaceSizes.Size();
+  *ReportStats<T>(report) = hull.mStats;
+  if (!settings.mWriteMeshes) {
+    return;
+  }
+
+  start = std::chrono::steady_clock::now();
+  std::string stem = report->mInput == "-"
+    ? "stdin"
+    : std::filesystem::path(report->mInput).stem().string();
+  std::string base = settings.mOutputDirectory + "/" + stem;
+  HullMesh mesh = HullMesh::Create(hull);
+  Result result = mesh.WriteObj(base + ".obj");
+  if (result.Success()) {
+    result = mesh.Write(base + ".vmesh");
+  }
+  report->mWriteMs = MsSince(start);
+  if (!result.Success()) {
+    report->mError = result.mError;
+  }
+}
+
+void ProcessInput(const Settings& settings, Report* report) {
+  auto start = std::chrono::steady_clock::now();
+  VResult<Ds::Vector<Vec3>> pointsResult = LoadPoints(report->mInput);
+  report->mLoadMs = MsSince(start);
+  if (!pointsResult.Success()) {
+    report->mError = pointsResult.mError;
+    return;
+  }
+  report->mPointCount = pointsResult.mValue.Size();
+  if (settings.mDouble) {
+    BuildHull<double>(settings, pointsResult.mValue, report);
+  }
+  else {
+    BuildHull<float>(settings, pointsResult.mValue, report);
+  }
+}
+
+template<typename T>
+void PrintStats(const std::string& input, Report* report) {
+  using Stats = typename ConvexHull<T>::Stats;
+  const Stats& stats = *ReportStats<T>(report);
+  std::printf("\n%s\n", input.c_str());
+  std::printf(
+    "  iterations %u, faces created %u, faces deleted %u\n",
+    stats.mIterations,
+    stats.mFacesCreated,
+    stats.mFacesDeleted);
+  std::printf(
+    "  plane evaluations %llu, conflict reassignments %llu\n",
+    (unsigned long long)stats.mPlaneEvaluations,
+    (unsigned long long)stats.mConflictReassignments);
+  std::printf(
+    "  coplanar merges %u, triangle removals %u, colinear merges %u\n",
+    stats.mCoplanarMerges,
+    stats.mTriangleRemovals,
+    stats.mColinearMerges);
+  std::printf("  horizon sizes (max %u):", stats.mMaxHorizonSize);
+  for (int b = 0; b < Stats::smHorizonBuckets; ++b) {
+    if (stats.mHorizonSizes[b] == 0) {
+      continue;
+    }
+    bool last = b == Stats::smHorizonBuckets - 1;
+    std::printf(" %d%s:%u", b, last ? "+" : "", stats.mHorizonSizes[b]);
+  }
+  std::printf("\n  phase ms:");
+  for (int p = 0; p < Stats::PhaseCount; ++p) {
+    std::printf(
+      " %s %.3f", Stats::smPhaseNames[p], stats.mPhaseTimes[p] / 1.0e6);
+  }
+  std::printf("\n");
+}
+
+VResult<Settings> ParseArguments(int argc, char* argv[]) {
+  Settings settings;
+  for (int i = 1; i < argc; ++i) {
+    std::string argument = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (argument == "-o" && hasValue) {
+      settings.mOutputDirectory = argv[++i];
+    }
+    else if (argument == "-j" && hasValue) {
+      settings.mThreadCount =
+        (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (argument == "--max-vertices" && hasValue) {
+      settings.mOptions.mMaxVertices =
+        (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (argument == "--tolerance" && hasValue) {
+      settings.mOptions.mTolerance = std::strtof(argv[++i], nullptr);
+    }
+    else if (argument == "--double") {
+      settings.mDouble = true;
+    }
+    else if (argument == "--no-mesh") {
+      settings.mWriteMeshes = false;
+    }
+    else if (argument == "--stats") {
+      settings.mPrintStats = true;
+    }
+    else if (argument == "-" || argument[0] != '-') {
+      settings.mInputs.Push(argument);
+    }
+    else {
+      return Result("Unknown or incomplete option \"" + argument + "\".");
+    }
+  }
+  if (settings.mInputs.Empty()) {
+    return Result("No inputs were given.");
+  }
+  return settings;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  VResult<Settings> settingsResult = ParseArguments(argc, argv);
+  if (!settingsResult.Success()) {
+    std::fprintf(stderr, "%s\n%s", settingsResult.mError.c_str(), nUsage);
+    return 2;
+  }
+  const Settings& settings = settingsResult.mValue;
+  if (settings.mWriteMeshes) {
+    std::error_code error;
+    std::filesystem::create_directories(settings.mOutputDirectory, error);
+  }
+
+  // Reports are sized up front so every job writes to its own slot.
+  Ds::Vector<Report> reports;
+  reports.Resize(settings.mInputs.Size());
+  auto start = std::chrono::steady_clock::now();
+  {
+    WorkerPool pool(settings.mThreadCount);
+    for (size_t i = 0; i < reports.Size(); ++i) {
+      Report* report = &reports[i];
+      report->mInput = settings.mInputs[i];
+      pool.Enqueue([&settings, report]() {
+        ProcessInput(settings, report);
+      });
+    }
+    pool.Wait();
+  }
+  double totalMs = MsSince(start);
+
+  int failures = 0;
+  std::printf("input\tpoints\tvertices\tfaces\tload_ms\tbuild_ms\twrite_ms\n");
+  for (const Report& report: reports) {
+    if (!report.mError.empty()) {
+      std::fprintf(
+        stderr, "%s: %s\n", report.mInput.c_str(), report.mError.c_str());
+      ++failures;
+      continue;
+    }
+    std::printf(
+      "%s\t%zu\t%zu\t%zu\t%.3f\t%.3f\t%.3f\n",
+      report.mInput.c_str(),
+      report.mPointCount,
+      report.mVertexCount,
+      report.mFaceCount,
+      report.mLoadMs,
+      report.mBuildMs,
+      report.mWriteMs);
+  }
+  if (settings.mPrintStats) {
+    for (Report& report: reports) {
+      if (!report.mError.empty()) {
+        continue;
+      }
+      if (settings.mDouble) {
+        PrintStats<double>(report.mInput, &report);
+      }
+      else {
+        PrintStats<float>(report.mInput, &report);
+      }
+    }
+  }
+  std::fprintf(
+    stderr,
+    "%zu inputs, %d failed, %.3f ms\n",
+    reports.Size(),
+    failures,
+    totalMs);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include "InstanceBatch.h"
+
+namespace {
+
+void LerpValues(
+  Vec3* values,
+  const unsigned int* instances,
+  const Vec3* starts,
+  const Vec3* ends,
+  size_t count,
+  float t) {
+  for (size_t i = 0; i < count; ++i) {
+    values[instances[i]] = Math::Lerp(starts[i], ends[i], t);
+  }
+}
+
+} // namespace
+
+InstanceBatch::InstanceBatch(unsigned int meshId): mMeshId(meshId) {}
+
+unsigned int InstanceBatch::Add(
+  const Vec3& translation,
+  const Quat& rotation,
+  const Vec3& scale,
+  unsigned int materialId,
+  bool visible) {
+  mTranslations.Push(translation);
+  mRotations.Push(rotation);
+  mScales.Push(scale);
+  mMaterialIds.Push(materialId);
+  mVisible.Push(visible);
+  mChanges.Push(0);
+  return (unsigned int)mVisible.Size() - 1;
+}
+
+size_t InstanceBatch::Size() const {
+  return mVisible.Size();
+}
+
+void InstanceBatch::SetVisible(unsigned int instance, bool visible) {
+  mVisible[instance] = visible;
+  Flag(instance, Change::Visible);
+}
+
+void InstanceBatch::SetMaterial(
+  unsigned int instance, unsigned int materialId) {
+  mMaterialIds[instance] = materialId;
+  Flag(instance, Change::Material);
+}
+
+void InstanceBatch::SetTranslation(
+  unsigned int instance, const Vec3& translation) {
+  mTranslations[instance] = translation;
+  Flag(instance, Change::Translation);
+}
+
+void InstanceBatch::SetScale(unsigned int instance, const Vec3& scale) {
+  mScales[instance] = scale;
+  Flag(instance, Change::Scale);
+}
+
+void InstanceBatch::SetRotation(unsigned int instance, const Quat& rotation) {
+  mRotations[instance] = rotation;
+  Flag(instance, Change::Rotation);
+}
+
+void InstanceBatch::LerpTranslations(
+  const unsigned int* instances,
+  const Vec3* starts,
+  const Vec3* ends,
+  size_t count,
+  float t) {
+  LerpValues(mTranslations.Data(), instances, starts, ends, count, t);
+}
+
+void InstanceBatch::LerpScales(
+  const unsigned int* instances,
+  const Vec3* starts,
+  const Vec3* ends,
+  size_t count,
+  float t) {
+  LerpValues(mScales.Data(), instances, starts, ends, count, t);
+}
+
+void InstanceBatch::Flag(unsigned int instance, Change change) {
+  if (mChanges[instance] == 0) {
+    mChangedInstances.Push(instance);
+  }
+  mChanges[instance] |= change;
+}
+
+void InstanceBatch::Flag(
+  const unsigned int* instances, size_t count, Change change) {
+  for (size_t i = 0; i < count; ++i) {
+    Flag(instances[i], change);
+  }
+}
@@ -0,0 +1,83 @@
+#ifndef InstanceBatch_h
+#define InstanceBatch_h
+
+#include <ds/Vector.h>
+#include <math/Quaternion.h>
+#include <math/Vector.h>
+#include <stdint.h>
+
+// The instances of one mesh stored in parallel arrays. Writes only touch the
+// arrays and flag what changed, so any number of writes to an instance within
+// a frame cost a single update of whatever presents it. Nothing here depends
+// on a window or a graphics context.
+struct InstanceBatch {
+  enum Change : uint8_t {
+    Visible = 1 << 0,
+    Material = 1 << 1,
+    Translation = 1 << 2,
+    Scale = 1 << 3,
+    Rotation = 1 << 4,
+  };
+
+  InstanceBatch(unsigned int meshId);
+  unsigned int Add(
+    const Vec3& translation,
+    const Quat& rotation,
+    const Vec3& scale,
+    unsigned int materialId,
+    bool visible);
+  size_t Size() const;
+
+  void SetVisible(unsigned int instance, bool visible);
+  void SetMaterial(unsigned int instance, unsigned int materialId);
+  void SetTranslation(unsigned int instance, const Vec3& translation);
+  void SetScale(unsigned int instance, const Vec3& scale);
+  void SetRotation(unsigned int instance, const Quat& rotation);
+  // Interpolates the translations or scales of many instances at once. The
+  // instances, starts, and ends arrays all hold count values. Only the values
+  // are written, so calls for disjoint instances can run on separate threads.
+  // The instances must be flagged with Flag afterwards.
+  void LerpTranslations(
+    const unsigned int* instances,
+    const Vec3* starts,
+    const Vec3* ends,
+    size_t count,
+    float t);
+  void LerpScales(
+    const unsigned int* instances,
+    const Vec3* starts,
+    const Vec3* ends,
+    size_t count,
+    float t);
+  void Flag(const unsigned int* instances, size_t count, Change change);
+
+  // Calls visit(instance, changes) for every instance that was written since
+  // the last visit, where changes is a mask of Change values.
+  template<typename F>
+  void VisitChanges(F visit);
+
+  unsigned int mMeshId;
+  Ds::Vector<Vec3> mTranslations;
+  Ds::Vector<Quat> mRotations;
+  Ds::Vector<Vec3> mScales;
+  Ds::Vector<unsigned int> mMaterialIds;
+  Ds::Vector<bool> mVisible;
+
+private:
+  void Flag(unsigned int instance, Change change);
+
+  // The changes of every instance and the instances that have any.
+  Ds::Vector<uint8_t> mChanges;
+  Ds::Vector<unsigned int> mChangedInstances;
+};
+
+template<typename F>
+void InstanceBatch::VisitChanges(F visit) {
+  for (unsigned int instance: mChangedInstances) {
+    visit(instance, mChanges[instance]);
+    mChanges[instance] = 0;
+  }
+  mChangedInstances.Clear();
+}
+
+#endif
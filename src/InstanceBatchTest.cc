@@ -0,0 +1,119 @@
+#include <cstdio>
+
+#include "InstanceBatch.h"
+
+// Checks the change tracking and the lerps of InstanceBatch. It only needs the
+// batch itself, so it runs without the engine or a display. The exit code is
+// the number of failed checks.
+
+namespace {
+
+int nFailures = 0;
+
+void Check(bool condition, const char* description) {
+  if (!condition) {
+    std::printf("failed: %s\n", description);
+    ++nFailures;
+  }
+}
+
+struct Visit {
+  unsigned int mInstance;
+  uint8_t mChanges;
+};
+
+Ds::Vector<Visit> VisitAll(InstanceBatch* batch) {
+  Ds::Vector<Visit> visits;
+  batch->VisitChanges([&](unsigned int instance, uint8_t changes) {
+    visits.Push({instance, changes});
+  });
+  return visits;
+}
+
+InstanceBatch CreateBatch(unsigned int count) {
+  InstanceBatch batch(0);
+  for (unsigned int i = 0; i < count; ++i) {
+    batch.Add({0, 0, 0}, {1, 0, 0, 0}, {1, 1, 1}, 0, true);
+  }
+  return batch;
+}
+
+void TestFlag() {
+  InstanceBatch batch = CreateBatch(4);
+  Check(VisitAll(&batch).Empty(), "Add does not flag instances");
+
+  unsigned int instances[] = {2, 0, 2};
+  batch.Flag(instances, 3, InstanceBatch::Translation);
+  batch.Flag(instances, 1, InstanceBatch::Scale);
+  batch.SetVisible(3, false);
+  Ds::Vector<Visit> visits = VisitAll(&batch);
+  Check(visits.Size() == 3, "Flag visits each flagged instance once");
+  Check(
+    visits.Size() == 3 && visits[0].mInstance == 2 &&
+      visits[1].mInstance == 0 && visits[2].mInstance == 3,
+    "Flag visits instances in the order they were first flagged");
+  Check(
+    visits.Size() == 3 &&
+      visits[0].mChanges ==
+        (InstanceBatch::Translation | InstanceBatch::Scale) &&
+      visits[1].mChanges == InstanceBatch::Translation &&
+      visits[2].mChanges == InstanceBatch::Visible,
+    "Flag combines the changes of an instance");
+}
+
+void TestVisitChanges() {
+  InstanceBatch batch = CreateBatch(3);
+  batch.SetMaterial(1, 5);
+  batch.SetRotation(1, {0, 1, 0, 0});
+  Ds::Vector<Visit> visits = VisitAll(&batch);
+  Check(
+    visits.Size() == 1 && visits[0].mInstance == 1 &&
+      visits[0].mChanges ==
+        (InstanceBatch::Material | InstanceBatch::Rotation),
+    "VisitChanges reports the setters' changes");
+  Check(batch.mMaterialIds[1] == 5, "SetMaterial writes the material");
+  Check(VisitAll(&batch).Empty(), "VisitChanges clears the changes");
+
+  batch.SetScale(1, {2, 2, 2});
+  visits = VisitAll(&batch);
+  Check(
+    visits.Size() == 1 && visits[0].mChanges == InstanceBatch::Scale,
+    "An instance is flagged again after a visit");
+}
+
+void TestLerpTranslations() {
+  InstanceBatch batch = CreateBatch(4);
+  unsigned int instances[] = {3, 1};
+  Vec3 starts[] = {{0, 0, 0}, {2, 4, 6}};
+  Vec3 ends[] = {{4, 8, 12}, {4, 4, 4}};
+  batch.LerpTranslations(instances, starts, ends, 2, 0.5f);
+  const Vec3& three = batch.mTranslations[3];
+  const Vec3& one = batch.mTranslations[1];
+  Check(
+    three[0] == 2 && three[1] == 4 && three[2] == 6,
+    "LerpTranslations interpolates the first instance");
+  Check(
+    one[0] == 3 && one[1] == 4 && one[2] == 5,
+    "LerpTranslations interpolates the second instance");
+  const Vec3& zero = batch.mTranslations[0];
+  Check(
+    zero[0] == 0 && zero[1] == 0 && zero[2] == 0,
+    "LerpTranslations leaves other instances alone");
+  Check(batch.mScales[3][0] == 1, "LerpTranslations leaves the scales alone");
+  Check(VisitAll(&batch).Empty(), "LerpTranslations does not flag instances");
+
+  batch.Flag(instances, 2, InstanceBatch::Translation);
+  Check(VisitAll(&batch).Size() == 2, "Lerped instances are flagged by Flag");
+}
+
+} // namespace
+
+int main() {
+  TestFlag();
+  TestVisitChanges();
+  TestLerpTranslations();
+  if (nFailures == 0) {
+    std::printf("All checks passed.\n");
+  }
+  return nFailures;
+}
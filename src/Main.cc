@@ -9,11 +9,13 @@
 #include <ds/Vector.h>
 #include <editor/Editor.h>
 #include <editor/LayerInterface.h>
+#include <float.h>
 #include <gfx/Font.h>
 #include <imgui/imgui.h>
 #include <math.h>
 #include <math/Constants.h>
 #include <math/Utility.h>
+#include <string>
 #include <util/Utility.h>
 #include <world/Registrar.h>
 #include <world/World.h>
@@ -26,6 +28,119 @@ void CentralUpdate() {
   gVid.mSeq.Update(Temporal::DeltaTime());
 }
 
+// Controls the sequence's profiling and shows the events that took the longest
+// since the profile was last cleared.
+void ProfileExtension() {
+  static std::string traceStatus;
+  Sequence& seq = gVid.mSeq;
+  ImGui::Checkbox("Profile", &seq.mProfiling);
+  ImGui::SameLine();
+  if (ImGui::Button("Clear")) {
+    seq.ClearProfile();
+    traceStatus.clear();
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Write Trace")) {
+    std::string filename =
+      std::string(PROJECT_DIRECTORY) + "/sequence_trace.json";
+    Result result = seq.WriteProfileTrace(filename);
+    traceStatus = result.Success() ? "Wrote " + filename : result.mError;
+  }
+  if (!traceStatus.empty()) {
+    ImGui::TextWrapped("%s", traceStatus.c_str());
+  }
+  if (seq.mProfileFrames.Empty()) {
+    return;
+  }
+
+  int64_t frameTime = 0;
+  for (const Sequence::ProfileFrame& frame: seq.mProfileFrames) {
+    frameTime += frame.mDuration;
+  }
+  ImGui::Text(
+    "Frames: %zu, Last: %.3f ms, Average: %.3f ms",
+    seq.mProfileFrames.Size(),
+    seq.mProfileFrames.Top().mDuration / 1.0e6,
+    frameTime / 1.0e6 / seq.mProfileFrames.Size());
+  constexpr size_t topCount = 12;
+  Ds::Vector<Sequence::ProfiledEvent> events = seq.ProfiledEvents(topCount);
+  if (!ImGui::BeginTable("ProfiledEvents", 4, ImGuiTableFlags_Borders)) {
+    return;
+  }
+  ImGui::TableSetupColumn("Event");
+  ImGui::TableSetupColumn("Calls");
+  ImGui::TableSetupColumn("Total ms");
+  ImGui::TableSetupColumn("Max ms");
+  ImGui::TableHeadersRow();
+  for (const Sequence::ProfiledEvent& event: events) {
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(event.mName.c_str());
+    ImGui::TableNextColumn();
+    ImGui::Text("%zu", event.mTotals.mCalls);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", event.mTotals.mTime / 1.0e6);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", event.mTotals.mMaxTime / 1.0e6);
+  }
+  ImGui::EndTable();
+}
+
+// Shows the counters and phase times of the builds of the animated hulls.
+void HullStatsExtension() {
+  using Stats = ConvexHull<float>::Stats;
+  if (!ImGui::CollapsingHeader("Hull Stats")) {
+    return;
+  }
+  // The hulls of a baked sequence are only acquired once the stats are shown.
+  const Ds::Vector<const ConvexHull<float>*>& hulls = QuickHullHulls();
+  if (hulls.Empty()) {
+    ImGui::TextWrapped("No hulls were acquired.");
+    return;
+  }
+  for (size_t h = 0; h < hulls.Size(); ++h) {
+    const Stats& stats = hulls[h]->mStats;
+    if (!ImGui::TreeNode((void*)h, "Hull %zu", h)) {
+      continue;
+    }
+    ImGui::Text("Iterations: %u", stats.mIterations);
+    ImGui::Text(
+      "Faces Created: %u, Deleted: %u",
+      stats.mFacesCreated,
+      stats.mFacesDeleted);
+    ImGui::Text(
+      "Plane Evaluations: %llu",
+      (unsigned long long)stats.mPlaneEvaluations);
+    ImGui::Text(
+      "Conflict Reassignments: %llu",
+      (unsigned long long)stats.mConflictReassignments);
+    ImGui::Text(
+      "Coplanar Merges: %u, Triangle Removals: %u, Colinear Merges: %u",
+      stats.mCoplanarMerges,
+      stats.mTriangleRemovals,
+      stats.mColinearMerges);
+    ImGui::Text("Max Horizon Size: %u", stats.mMaxHorizonSize);
+    float histogram[Stats::smHorizonBuckets];
+    for (int b = 0; b < Stats::smHorizonBuckets; ++b) {
+      histogram[b] = (float)stats.mHorizonSizes[b];
+    }
+    ImGui::PlotHistogram(
+      "Horizon Sizes",
+      histogram,
+      Stats::smHorizonBuckets,
+      0,
+      nullptr,
+      0.0f,
+      FLT_MAX,
+      ImVec2(0.0f, 60.0f));
+    for (int p = 0; p < Stats::PhaseCount; ++p) {
+      ImGui::Text(
+        "%s: %.3f ms", Stats::smPhaseNames[p], stats.mPhaseTimes[p] / 1.0e6);
+    }
+    ImGui::TreePop();
+  }
+}
+
 void EditorExtension() {
   ImGui::Begin("Sequence");
   float time = gVid.mSeq.mTimePassed;
@@ -35,6 +150,9 @@ void EditorExtension() {
     World::nPause = true;
     gVid.mSeq.Scrub(time);
   }
+  ImGui::Text("Uniform Writes: %u", gVid.mSeq.mUniformWrites);
+  ProfileExtension();
+  HullStatsExtension();
   ImGui::End();
 }
 
@@ -0,0 +1,132 @@
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+#include <utility>
+
+#include "MappedFile.h"
+
+MappedFile::MappedFile(): mData(nullptr), mSize(0) {
+#ifdef _WIN32
+  mFile = INVALID_HANDLE_VALUE;
+  mMapping = nullptr;
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other): MappedFile() {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+  if (this == &other) {
+    return *this;
+  }
+  Purge();
+  std::swap(mData, other.mData);
+  std::swap(mSize, other.mSize);
+#ifdef _WIN32
+  std::swap(mFile, other.mFile);
+  std::swap(mMapping, other.mMapping);
+#endif
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  Purge();
+}
+
+VResult<MappedFile> MappedFile::Init(const std::string& filename) {
+  MappedFile file;
+#ifdef _WIN32
+  file.mFile = CreateFileA(
+    filename.c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_FLAG_SEQUENTIAL_SCAN,
+    nullptr);
+  if (file.mFile == INVALID_HANDLE_VALUE) {
+    return Result("Failed to open \"" + filename + "\".");
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file.mFile, &size)) {
+    return Result("Failed to get the size of \"" + filename + "\".");
+  }
+  file.mSize = (size_t)size.QuadPart;
+  if (file.mSize == 0) {
+    return file;
+  }
+  file.mMapping =
+    CreateFileMappingA(file.mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (file.mMapping == nullptr) {
+    return Result("Failed to map \"" + filename + "\".");
+  }
+  file.mData =
+    (const char*)MapViewOfFile(file.mMapping, FILE_MAP_READ, 0, 0, 0);
+  if (file.mData == nullptr) {
+    return Result("Failed to view \"" + filename + "\".");
+  }
+#else
+  int descriptor = open(filename.c_str(), O_RDONLY);
+  if (descriptor == -1) {
+    return Result("Failed to open \"" + filename + "\".");
+  }
+  struct stat status;
+  if (fstat(descriptor, &status) == -1) {
+    close(descriptor);
+    return Result("Failed to get the size of \"" + filename + "\".");
+  }
+  file.mSize = (size_t)status.st_size;
+  if (file.mSize == 0) {
+    close(descriptor);
+    return file;
+  }
+  void* data = mmap(nullptr, file.mSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  // The mapping holds its own reference to the file.
+  close(descriptor);
+  if (data == MAP_FAILED) {
+    file.mSize = 0;
+    return Result("Failed to map \"" + filename + "\".");
+  }
+  madvise(data, file.mSize, MADV_SEQUENTIAL);
+  file.mData = (const char*)data;
+#endif
+  return file;
+}
+
+const char* MappedFile::Data() const {
+  return mData;
+}
+
+size_t MappedFile::Size() const {
+  return mSize;
+}
+
+void MappedFile::Purge() {
+#ifdef _WIN32
+  if (mData != nullptr) {
+    UnmapViewOfFile(mData);
+  }
+  if (mMapping != nullptr) {
+    CloseHandle(mMapping);
+  }
+  if (mFile != INVALID_HANDLE_VALUE) {
+    CloseHandle(mFile);
+  }
+  mFile = INVALID_HANDLE_VALUE;
+  mMapping = nullptr;
+#else
+  if (mData != nullptr) {
+    munmap((void*)mData, mSize);
+  }
+#endif
+  mData = nullptr;
+  mSize = 0;
+}
@@ -0,0 +1,32 @@
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <Result.h>
+#include <string>
+
+// A read-only view of a file that is paged in by the operating system instead
+// of being copied into a heap buffer.
+struct MappedFile {
+  MappedFile();
+  MappedFile(MappedFile&& other);
+  MappedFile& operator=(MappedFile&& other);
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile& operator=(const MappedFile& other) = delete;
+  ~MappedFile();
+  static VResult<MappedFile> Init(const std::string& filename);
+
+  const char* Data() const;
+  size_t Size() const;
+
+private:
+  void Purge();
+
+  const char* mData;
+  size_t mSize;
+#ifdef _WIN32
+  void* mFile;
+  void* mMapping;
+#endif
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+#include "MappedFile.h"
+#include "ObjPoints.h"
+
+namespace {
+
+// Files are only split between threads when every thread receives at least
+// this many bytes. Below that, thread creation costs more than it saves.
+constexpr size_t nMinBytesPerThread = 1 << 20;
+
+struct Range {
+  const char* mStart;
+  const char* mEnd;
+  size_t mFirstPoint;
+  size_t mPointCount;
+  bool mValid;
+};
+
+const char* NextLine(const char* c, const char* end) {
+  const char* newline = (const char*)std::memchr(c, '\n', end - c);
+  if (newline == nullptr) {
+    return end;
+  }
+  return newline + 1;
+}
+
+const char* SkipBlanks(const char* c, const char* end) {
+  while (c < end && (*c == ' ' || *c == '\t')) {
+    ++c;
+  }
+  return c;
+}
+
+// The line must start after any leading blanks.
+bool IsVertexLine(const char* line, const char* lineEnd) {
+  return lineEnd - line > 2 && line[0] == 'v' &&
+    (line[1] == ' ' || line[1] == '\t');
+}
+
+void CountPoints(Range* range) {
+  range->mPointCount = 0;
+  const char* line = range->mStart;
+  while (line < range->mEnd) {
+    const char* lineEnd = NextLine(line, range->mEnd);
+    if (IsVertexLine(SkipBlanks(line, lineEnd), lineEnd)) {
+      ++range->mPointCount;
+    }
+    line = lineEnd;
+  }
+}
+
+// Each vertex line is parsed directly into its final slot of the output.
+void ParsePoints(Range* range, Vec3* points) {
+  Vec3* point = points + range->mFirstPoint;
+  const char* line = range->mStart;
+  while (line < range->mEnd) {
+    const char* lineEnd = NextLine(line, range->mEnd);
+    const char* vertex = SkipBlanks(line, lineEnd);
+    if (!IsVertexLine(vertex, lineEnd)) {
+      line = lineEnd;
+      continue;
+    }
+    const char* c = vertex + 2;
+    for (int i = 0; i < 3; ++i) {
+      c = SkipBlanks(c, lineEnd);
+      std::from_chars_result result = std::from_chars(c, lineEnd, (*point)[i]);
+      if (result.ec != std::errc()) {
+        range->mValid = false;
+        return;
+      }
+      c = result.ptr;
+    }
+    ++point;
+    line = lineEnd;
+  }
+}
+
+template<typename F>
+void ForEachRange(Ds::Vector<Range>& ranges, F function) {
+  Ds::Vector<std::thread> threads;
+  for (size_t i = 1; i < ranges.Size(); ++i) {
+    threads.Emplace(function, &ranges[i]);
+  }
+  function(&ranges[0]);
+  for (std::thread& thread: threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+VResult<Ds::Vector<Vec3>> LoadObjPoints(
+  const std::string& filename, unsigned int threadCount) {
+  VResult<MappedFile> fileResult = MappedFile::Init(filename);
+  if (!fileResult.Success()) {
+    return Result(fileResult.mError);
+  }
+  const MappedFile& file = fileResult.mValue;
+  const char* start = file.Data();
+  const char* end = start + file.Size();
+
+  if (threadCount == 0) {
+    threadCount = std::thread::hardware_concurrency();
+  }
+  size_t maxThreadCount = file.Size() / nMinBytesPerThread;
+  if (threadCount > maxThreadCount) {
+    threadCount = (unsigned int)maxThreadCount;
+  }
+  if (threadCount == 0) {
+    threadCount = 1;
+  }
+
+  // Every range begins on the first line that starts at or after an even
+  // split of the file so no line is shared between two ranges.
+  Ds::Vector<Range> ranges;
+  const char* rangeStart = start;
+  for (unsigned int i = 1; i <= threadCount; ++i) {
+    const char* rangeEnd = end;
+    if (i < threadCount) {
+      rangeEnd = start + file.Size() / threadCount * i;
+      rangeEnd = NextLine(rangeEnd - 1, end);
+    }
+    if (rangeEnd < rangeStart) {
+      rangeEnd = rangeStart;
+    }
+    ranges.Push({rangeStart, rangeEnd, 0, 0, true});
+    rangeStart = rangeEnd;
+  }
+
+  // Counting first lets us allocate the output once and have each thread
+  // write its points without any synchronization.
+  ForEachRange(ranges, CountPoints);
+  size_t pointCount = 0;
+  for (Range& range: ranges) {
+    range.mFirstPoint = pointCount;
+    pointCount += range.mPointCount;
+  }
+  Ds::Vector<Vec3> points;
+  points.Resize(pointCount);
+  Vec3* pointData = points.Data();
+  ForEachRange(ranges, [pointData](Range* range) {
+    ParsePoints(range, pointData);
+  });
+  for (const Range& range: ranges) {
+    if (!range.mValid) {
+      return Result("\"" + filename + "\" contains a malformed vertex.");
+    }
+  }
+  return points;
+}
@@ -0,0 +1,16 @@
+#ifndef ObjPoints_h
+#define ObjPoints_h
+
+#include <Result.h>
+#include <ds/Vector.h>
+#include <math/Vector.h>
+#include <string>
+
+// Reads the vertex positions of an obj file and ignores every other statement.
+// The file is memory mapped and, when it is large enough, split into byte
+// ranges that are parsed on separate threads. A thread count of 0 uses the
+// hardware concurrency.
+VResult<Ds::Vector<Vec3>> LoadObjPoints(
+  const std::string& filename, unsigned int threadCount = 0);
+
+#endif
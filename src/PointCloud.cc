@@ -0,0 +1,147 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "ObjPoints.h"
+#include "PointCloud.h"
+
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 must be packed.");
+
+PointCloud::PointCloud(): mPoints(nullptr), mCount(0) {}
+
+VResult<PointCloud> PointCloud::Init(const std::string& filename) {
+  VResult<MappedFile> fileResult = MappedFile::Init(filename);
+  if (!fileResult.Success()) {
+    return Result(fileResult.mError);
+  }
+  PointCloud cloud;
+  cloud.mFile = std::move(fileResult.mValue);
+  if (cloud.mFile.Size() < sizeof(Header)) {
+    return Result("\"" + filename + "\" is too small to be a point cloud.");
+  }
+  Header header;
+  std::memcpy(&header, cloud.mFile.Data(), sizeof(Header));
+  if (header.mMagic != smMagic) {
+    return Result("\"" + filename + "\" is not a point cloud.");
+  }
+  if (header.mVersion != smVersion) {
+    return Result("\"" + filename + "\" has an outdated version.");
+  }
+  if (cloud.mFile.Size() != sizeof(Header) + header.mCount * sizeof(Vec3)) {
+    return Result("\"" + filename + "\" is truncated.");
+  }
+  cloud.mPoints = (const Vec3*)(cloud.mFile.Data() + sizeof(Header));
+  cloud.mCount = (size_t)header.mCount;
+  cloud.mMin = {header.mMin[0], header.mMin[1], header.mMin[2]};
+  cloud.mMax = {header.mMax[0], header.mMax[1], header.mMax[2]};
+  return cloud;
+}
+
+Result PointCloud::Write(
+  const std::string& filename,
+  const Ds::Vector<Vec3>& points,
+  uint64_t sourceSize,
+  int64_t sourceTime) {
+  Header header;
+  header.mMagic = smMagic;
+  header.mVersion = smVersion;
+  header.mSourceSize = sourceSize;
+  header.mSourceTime = sourceTime;
+  header.mCount = points.Size();
+  for (int i = 0; i < 3; ++i) {
+    header.mMin[i] = points.Empty() ? 0.0f : points[0][i];
+    header.mMax[i] = header.mMin[i];
+  }
+  for (const Vec3& point: points) {
+    for (int i = 0; i < 3; ++i) {
+      header.mMin[i] = point[i] < header.mMin[i] ? point[i] : header.mMin[i];
+      header.mMax[i] = point[i] > header.mMax[i] ? point[i] : header.mMax[i];
+    }
+  }
+
+  // The points are written to a temporary file first so a reader never maps
+  // a partially written point cloud.
+  std::string tempFilename = filename + ".tmp";
+  std::ofstream file(tempFilename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Result("Failed to open \"" + tempFilename + "\".");
+  }
+  file.write((const char*)&header, sizeof(Header));
+  file.write((const char*)points.CData(), points.Size() * sizeof(Vec3));
+  file.close();
+  if (file.fail()) {
+    return Result("Failed to write \"" + tempFilename + "\".");
+  }
+  std::error_code error;
+  std::filesystem::rename(tempFilename, filename, error);
+  if (error) {
+    return Result("Failed to replace \"" + filename + "\".");
+  }
+  return Result();
+}
+
+VResult<PointCloud> PointCloud::Acquire(const std::string& objFilename) {
+  std::error_code error;
+  uint64_t sourceSize = std::filesystem::file_size(objFilename, error);
+  if (error) {
+    return Result("Failed to find \"" + objFilename + "\".");
+  }
+  int64_t sourceTime = (int64_t)std::filesystem::last_write_time(objFilename)
+                         .time_since_epoch()
+                         .count();
+
+  std::string cacheFilename = objFilename + smExtension;
+  VResult<PointCloud> cached = Init(cacheFilename);
+  if (cached.Success()) {
+    Header header;
+    std::memcpy(&header, cached.mValue.mFile.Data(), sizeof(Header));
+    if (header.mSourceSize == sourceSize && header.mSourceTime == sourceTime) {
+      return std::move(cached.mValue);
+    }
+  }
+
+  VResult<Ds::Vector<Vec3>> loaded = LoadObjPoints(objFilename);
+  if (!loaded.Success()) {
+    return Result(loaded.mError);
+  }
+  Result writeResult =
+    Write(cacheFilename, loaded.mValue, sourceSize, sourceTime);
+  if (writeResult.Success()) {
+    VResult<PointCloud> converted = Init(cacheFilename);
+    if (converted.Success()) {
+      return std::move(converted.mValue);
+    }
+  }
+
+  // Failing to cache the conversion only costs the next run a parse.
+  PointCloud cloud;
+  cloud.mOwnedPoints = std::move(loaded.mValue);
+  cloud.mPoints = cloud.mOwnedPoints.CData();
+  cloud.mCount = cloud.mOwnedPoints.Size();
+  cloud.mMin = {0.0f, 0.0f, 0.0f};
+  cloud.mMax = {0.0f, 0.0f, 0.0f};
+  for (size_t p = 0; p < cloud.mCount; ++p) {
+    for (int i = 0; i < 3; ++i) {
+      const float value = cloud.mPoints[p][i];
+      cloud.mMin[i] = p == 0 || value < cloud.mMin[i] ? value : cloud.mMin[i];
+      cloud.mMax[i] = p == 0 || value > cloud.mMax[i] ? value : cloud.mMax[i];
+    }
+  }
+  return cloud;
+}
+
+const Vec3* PointCloud::Points() const {
+  return mPoints;
+}
+
+size_t PointCloud::Count() const {
+  return mCount;
+}
+
+const Vec3& PointCloud::Min() const {
+  return mMin;
+}
+
+const Vec3& PointCloud::Max() const {
+  return mMax;
+}
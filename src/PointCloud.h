@@ -0,0 +1,57 @@
+#ifndef PointCloud_h
+#define PointCloud_h
+
+#include <Result.h>
+#include <ds/Vector.h>
+#include <math/Vector.h>
+#include <stdint.h>
+#include <string>
+
+#include "MappedFile.h"
+
+// A set of points stored in a compact binary file. The file is a Header
+// followed by mCount float32 xyz triples, so a mapped file is used as is.
+struct PointCloud {
+  struct Header {
+    uint32_t mMagic;
+    uint32_t mVersion;
+    // The size and modification time of the file the points were taken from.
+    uint64_t mSourceSize;
+    int64_t mSourceTime;
+    uint64_t mCount;
+    float mMin[3];
+    float mMax[3];
+  };
+  static constexpr uint32_t smMagic = 0x4c435056; // "VPCL"
+  static constexpr uint32_t smVersion = 1;
+  static constexpr const char* smExtension = ".vpc";
+
+  PointCloud();
+  static VResult<PointCloud> Init(const std::string& filename);
+  static Result Write(
+    const std::string& filename,
+    const Ds::Vector<Vec3>& points,
+    uint64_t sourceSize,
+    int64_t sourceTime);
+  // Provides the points of an obj file. The first use converts the obj into
+  // a point cloud file that sits beside it and later uses map that file
+  // instead of parsing the obj. The conversion is redone whenever the obj's
+  // size or modification time no longer match those in the header.
+  static VResult<PointCloud> Acquire(const std::string& objFilename);
+
+  const Vec3* Points() const;
+  size_t Count() const;
+  const Vec3& Min() const;
+  const Vec3& Max() const;
+
+private:
+  MappedFile mFile;
+  // Only used when the converted points could not be written to disk.
+  Ds::Vector<Vec3> mOwnedPoints;
+  const Vec3* mPoints;
+  size_t mCount;
+  Vec3 mMin;
+  Vec3 mMax;
+};
+
+#endif
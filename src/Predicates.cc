@@ -0,0 +1,155 @@
+#include <cmath>
+
+#include "Predicates.h"
+
+namespace Predicates {
+namespace {
+
+// Half of the distance between 1 and the next double. The error bounds of the
+// fast paths are taken from Shewchuk's "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates".
+constexpr double nHalfUlp = 1.1102230246251565e-16;
+constexpr double nOrient2dBound = (3.0 + 16.0 * nHalfUlp) * nHalfUlp;
+constexpr double nOrient3dBound = (7.0 + 56.0 * nHalfUlp) * nHalfUlp;
+
+// The sum and product of two doubles as an unevaluated sum of a rounded result
+// and its exact rounding error.
+void TwoSum(double a, double b, double* sum, double* error) {
+  *sum = a + b;
+  double bVirtual = *sum - a;
+  double aVirtual = *sum - bVirtual;
+  *error = (a - aVirtual) + (b - bVirtual);
+}
+
+void TwoProduct(double a, double b, double* product, double* error) {
+  *product = a * b;
+  *error = std::fma(a, b, -*product);
+}
+
+// A value represented exactly as a sum of nonoverlapping doubles ordered by
+// increasing magnitude. The last component therefore carries the sign.
+struct Expansion {
+  static constexpr int smMaxComponents = 128;
+  double mComponents[smMaxComponents];
+  int mSize = 0;
+
+  void Add(double value);
+  void AddProduct(double a, double b);
+  void AddProduct(double a, double b, double c);
+  double Estimate() const;
+};
+
+void Expansion::Add(double value) {
+  // Zero components are dropped so the expansion stays short.
+  double carry = value;
+  int size = 0;
+  for (int i = 0; i < mSize; ++i) {
+    double error;
+    TwoSum(carry, mComponents[i], &carry, &error);
+    if (error != 0.0) {
+      mComponents[size++] = error;
+    }
+  }
+  if (carry != 0.0 || size == 0) {
+    mComponents[size++] = carry;
+  }
+  mSize = size;
+}
+
+void Expansion::AddProduct(double a, double b) {
+  double product, error;
+  TwoProduct(a, b, &product, &error);
+  Add(error);
+  Add(product);
+}
+
+void Expansion::AddProduct(double a, double b, double c) {
+  double product, error;
+  TwoProduct(a, b, &product, &error);
+  double parts[4];
+  TwoProduct(product, c, &parts[1], &parts[0]);
+  TwoProduct(error, c, &parts[3], &parts[2]);
+  for (double part: parts) {
+    Add(part);
+  }
+}
+
+double Expansion::Estimate() const {
+  double estimate = 0.0;
+  for (int i = 0; i < mSize; ++i) {
+    estimate += mComponents[i];
+  }
+  return estimate;
+}
+
+// Adds sign * det([p, q, r]) where p, q, and r are the rows.
+void AddDeterminant(
+  Expansion* expansion,
+  const double p[3],
+  const double q[3],
+  const double r[3],
+  double sign) {
+  expansion->AddProduct(sign * p[0], q[1], r[2]);
+  expansion->AddProduct(-sign * p[0], q[2], r[1]);
+  expansion->AddProduct(-sign * p[1], q[0], r[2]);
+  expansion->AddProduct(sign * p[1], q[2], r[0]);
+  expansion->AddProduct(sign * p[2], q[0], r[1]);
+  expansion->AddProduct(-sign * p[2], q[1], r[0]);
+}
+
+} // namespace
+
+double Orient2d(const double a[2], const double b[2], const double c[2]) {
+  double detLeft = (b[0] - a[0]) * (c[1] - a[1]);
+  double detRight = (b[1] - a[1]) * (c[0] - a[0]);
+  double det = detLeft - detRight;
+  double errorBound =
+    nOrient2dBound * (std::fabs(detLeft) + std::fabs(detRight));
+  if (det > errorBound || -det > errorBound) {
+    return det;
+  }
+
+  // The exact determinant is expanded into products of the raw coordinates so
+  // no rounded difference is involved.
+  Expansion exact;
+  exact.AddProduct(b[0], c[1]);
+  exact.AddProduct(-b[1], c[0]);
+  exact.AddProduct(-a[0], c[1]);
+  exact.AddProduct(a[1], c[0]);
+  exact.AddProduct(a[0], b[1]);
+  exact.AddProduct(-a[1], b[0]);
+  return exact.Estimate();
+}
+
+double Orient3d(
+  const double a[3], const double b[3], const double c[3], const double d[3]) {
+  double ab[3], ac[3], ad[3];
+  for (int i = 0; i < 3; ++i) {
+    ab[i] = b[i] - a[i];
+    ac[i] = c[i] - a[i];
+    ad[i] = d[i] - a[i];
+  }
+  double bcx = ab[1] * ac[2], cbx = ab[2] * ac[1];
+  double bcy = ab[2] * ac[0], cby = ab[0] * ac[2];
+  double bcz = ab[0] * ac[1], cbz = ab[1] * ac[0];
+  double det =
+    ad[0] * (bcx - cbx) + ad[1] * (bcy - cby) + ad[2] * (bcz - cbz);
+  double permanent = std::fabs(ad[0]) * (std::fabs(bcx) + std::fabs(cbx)) +
+    std::fabs(ad[1]) * (std::fabs(bcy) + std::fabs(cby)) +
+    std::fabs(ad[2]) * (std::fabs(bcz) + std::fabs(cbz));
+  double errorBound = nOrient3dBound * permanent;
+  if (det > errorBound || -det > errorBound) {
+    return det;
+  }
+
+  // det([b - a, c - a, d - a]) expands to the determinants below, none of
+  // which contain a rounded difference.
+  Expansion exact;
+  AddDeterminant(&exact, b, c, d, 1.0);
+  AddDeterminant(&exact, a, c, d, -1.0);
+  AddDeterminant(&exact, a, b, d, 1.0);
+  AddDeterminant(&exact, a, b, c, -1.0);
+  return exact.Estimate();
+}
+
+} // namespace Predicates
@@ -0,0 +1,46 @@
+#ifndef Predicates_h
+#define Predicates_h
+
+#include <math/Vector.h>
+
+// Orientation tests whose signs are always correct. The determinant is first
+// evaluated in double precision and only recomputed with exact expansion
+// arithmetic when its magnitude is within the error bound of the fast path.
+namespace Predicates {
+
+// Positive when c lies to the left of the directed line from a to b, negative
+// when it lies to the right, and zero when the points are colinear.
+double Orient2d(const double a[2], const double b[2], const double c[2]);
+// Positive when d lies in front of the plane through a, b, and c, where the
+// front is the side Cross(b - a, c - a) points to. Zero when the points are
+// coplanar. The magnitude is six times the volume of the tetrahedron.
+double Orient3d(
+  const double a[3], const double b[3], const double c[3], const double d[3]);
+
+template<typename T>
+double Orient2d(
+  const Math::Vector<T, 2>& a,
+  const Math::Vector<T, 2>& b,
+  const Math::Vector<T, 2>& c) {
+  const double da[2] = {(double)a[0], (double)a[1]};
+  const double db[2] = {(double)b[0], (double)b[1]};
+  const double dc[2] = {(double)c[0], (double)c[1]};
+  return Orient2d(da, db, dc);
+}
+
+template<typename T>
+double Orient3d(
+  const Math::Vector<T, 3>& a,
+  const Math::Vector<T, 3>& b,
+  const Math::Vector<T, 3>& c,
+  const Math::Vector<T, 3>& d) {
+  const double da[3] = {(double)a[0], (double)a[1], (double)a[2]};
+  const double db[3] = {(double)b[0], (double)b[1], (double)b[2]};
+  const double dc[3] = {(double)c[0], (double)c[1], (double)c[2]};
+  const double dd[3] = {(double)d[0], (double)d[1], (double)d[2]};
+  return Orient3d(da, db, dc, dd);
+}
+
+} // namespace Predicates
+
+#endif
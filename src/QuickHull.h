@@ -2,9 +2,16 @@
 #define QuickHull_h
 
 #include <Result.h>
+#include <ds/Vector.h>
 
+#include "ConvexHull.h"
 #include "Video.h"
 
 Result QuickHullAnimation(Video* video);
+// The hulls the animation was generated from in the order they appear. Their
+// stats are those of the build that produced them. When the sequence was
+// loaded baked, the hulls are acquired by the first call, which may build the
+// ones missing from the hull cache.
+const Ds::Vector<const ConvexHull<float>*>& QuickHullHulls();
 
 #endif
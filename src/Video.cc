@@ -1,9 +1,27 @@
 #include <Error.h>
+#include <algorithm>
+#include <comp/Camera.h>
+#include <comp/Mesh.h>
+#include <comp/Transform.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gfx/Material.h>
+#include <math.h>
+#include <rsl/Library.h>
+#include <world/Object.h>
 
+#include "MappedFile.h"
 #include "Video.h"
 
 Sequence::Sequence():
-  mTimePassed(0.0f), mTotalTime(0.0f), mNextInactiveEvent(0) {}
+  mTimePassed(0.0f),
+  mTotalTime(0.0f),
+  mNextInactiveEvent(0),
+  mSpace(nullptr),
+  mUniformWrites(0),
+  mProfiling(false),
+  mProfileEpoch(std::chrono::steady_clock::now()) {}
 
 float Ease(float t, EaseType easeType) {
   switch (easeType) {
@@ -39,25 +57,105 @@ float Ease(float t, EaseType easeType) {
   return t;
 }
 
-void Sequence::DiscreteEvent::Run(float t) const {
-  if (mLerp) {
-    t = Ease(t, mEase);
-    mLerp(t);
-  }
+void Sequence::DiscreteEvent::StepVisible(
+  Phase phase, unsigned int element, bool before, bool after) {
+  mTracks.Push(
+    {phase,
+     Property::Visible,
+     element,
+     {before ? 1.0f : 0.0f, 0, 0, 0},
+     {after ? 1.0f : 0.0f, 0, 0, 0}});
+}
+
+void Sequence::DiscreteEvent::StepMaterial(
+  Phase phase, unsigned int element, unsigned int before, unsigned int after) {
+  mTracks.Push(
+    {phase,
+     Property::Material,
+     element,
+     {(float)before, 0, 0, 0},
+     {(float)after, 0, 0, 0}});
+}
+
+void Sequence::DiscreteEvent::StepTranslation(
+  Phase phase, unsigned int element, const Vec3& before, const Vec3& after) {
+  mTracks.Push(
+    {phase, Property::Translation, element, Vec4(before, 0), Vec4(after, 0)});
+}
+
+void Sequence::DiscreteEvent::StepScale(
+  Phase phase, unsigned int element, const Vec3& before, const Vec3& after) {
+  mTracks.Push(
+    {phase, Property::Scale, element, Vec4(before, 0), Vec4(after, 0)});
+}
+
+void Sequence::DiscreteEvent::StepRotation(
+  Phase phase, unsigned int element, const Quat& before, const Quat& after) {
+  mTracks.Push(
+    {phase,
+     Property::Rotation,
+     element,
+     {before.mA, before.mB, before.mC, before.mD},
+     {after.mA, after.mB, after.mC, after.mD}});
+}
+
+void Sequence::DiscreteEvent::StepColor(
+  Phase phase, unsigned int uniform, const Vec4& before, const Vec4& after) {
+  mTracks.Push({phase, Property::Color, uniform, before, after});
+}
+
+void Sequence::DiscreteEvent::LerpTranslation(
+  unsigned int element, const Vec3& start, const Vec3& end) {
+  mTracks.Push(
+    {Phase::Lerp,
+     Property::Translation,
+     element,
+     Vec4(start, 0),
+     Vec4(end, 0)});
+}
+
+void Sequence::DiscreteEvent::LerpScale(
+  unsigned int element, const Vec3& start, const Vec3& end) {
+  mTracks.Push(
+    {Phase::Lerp, Property::Scale, element, Vec4(start, 0), Vec4(end, 0)});
+}
+
+void Sequence::DiscreteEvent::LerpRotation(
+  unsigned int element, const Quat& start, const Quat& end) {
+  mTracks.Push(
+    {Phase::Lerp,
+     Property::Rotation,
+     element,
+     {start.mA, start.mB, start.mC, start.mD},
+     {end.mA, end.mB, end.mC, end.mD}});
+}
+
+void Sequence::DiscreteEvent::LerpColor(
+  unsigned int uniform, const Vec4& start, const Vec4& end) {
+  mTracks.Push({Phase::Lerp, Property::Color, uniform, start, end});
+}
+
+void Sequence::DiscreteEvent::LerpOrbit(
+  const Vec4& coefficients, float distance) {
+  mTracks.Push(
+    {Phase::Lerp, Property::Orbit, 0, coefficients, {distance, 0, 0, 0}});
 }
 
-void Sequence::AddDiscreteEvent(const DiscreteEvent& newDiscreteEvent) {
+Sequence::DiscreteEvent& Sequence::AddDiscreteEvent(
+  const DiscreteEvent& newDiscreteEvent) {
   for (int i = 0; i < mEvents.Size(); ++i) {
     const DiscreteEvent& discreteEvent = mEvents[i];
     if (newDiscreteEvent.mStartTime < discreteEvent.mStartTime) {
       mEvents.Insert(i, newDiscreteEvent);
-      return;
+      return mEvents[i];
     }
   }
   mEvents.Push(newDiscreteEvent);
+  return mEvents.Top();
 }
 
-void Sequence::AddContinuousEvent(const ContinuousEvent& newContinuousEvent) {
+Sequence::DiscreteEvent& Sequence::AddContinuousEvent(
+  const ContinuousEvent& newContinuousEvent) {
   DiscreteEvent newEvent;
   newEvent.mName = newContinuousEvent.mName;
   if (mEvents.Size() == 0) {
@@ -68,16 +166,19 @@ void Sequence::AddContinuousEvent(const ContinuousEvent& newContinuousEvent) {
   }
   newEvent.mEndTime = newEvent.mStartTime + newContinuousEvent.mDuration;
   newEvent.mEase = newContinuousEvent.mEase;
+  newEvent.mParallel = newContinuousEvent.mParallel;
   newEvent.mBegin = newContinuousEvent.mBegin;
   newEvent.mLerp = newContinuousEvent.mLerp;
   newEvent.mEnd = newContinuousEvent.mEnd;
   mEvents.Push(newEvent);
   mTotalTime = newEvent.mEndTime;
+  return mEvents.Top();
 }
 
 void Sequence::Gap(float duration) {
   DiscreteEvent newEvent;
   newEvent.mName = "Gap";
+  newEvent.mEase = EaseType::Linear;
   if (mEvents.Size() == 0) {
     newEvent.mStartTime = duration;
   }
@@ -94,6 +195,501 @@ void Sequence::Wait() {
   Gap(mEvents.Top().mEndTime - mEvents.Top().mStartTime);
 }
 
+unsigned int Sequence::AddString(const std::string& string) {
+  auto [entry, added] =
+    mStringIds.try_emplace(string, (unsigned int)mStrings.Size());
+  if (added) {
+    mStrings.Push(string);
+  }
+  return entry->second;
+}
+
+unsigned int Sequence::AddElement(
+  const std::string& meshId,
+  const std::string& materialId,
+  const Vec3& translation,
+  const Quat& rotation,
+  const Vec3& scale,
+  bool visible) {
+  mElements.Push(
+    {AddString(meshId),
+     AddString(materialId),
+     translation,
+     rotation,
+     scale,
+     visible});
+  return (unsigned int)mElements.Size() - 1;
+}
+
+unsigned int Sequence::AddUniform(
+  const std::string& materialId, const std::string& name) {
+  Uniform newUniform = {AddString(materialId), AddString(name)};
+  for (unsigned int i = 0; i < mUniforms.Size(); ++i) {
+    const Uniform& uniform = mUniforms[i];
+    if (
+      uniform.mMaterialId == newUniform.mMaterialId &&
+      uniform.mName == newUniform.mName) {
+      return i;
+    }
+  }
+  mUniforms.Push(newUniform);
+  return (unsigned int)mUniforms.Size() - 1;
+}
+
+void Sequence::Instantiate(World::Space* space, World::MemberId cameraId) {
+  mSpace = space;
+  mCameraId = cameraId;
+  mRootId = space->CreateObject().mMemberId;
+  mUniformStates.Clear();
+  mUniformStates.Resize(mUniforms.Size(), {{}, {}, false, false});
+  for (const Element& element: mElements) {
+    unsigned int batchIndex = 0;
+    while (
+      batchIndex < mBatches.Size() &&
+      mBatches[batchIndex].mInstances.mMeshId != element.mMeshId) {
+      ++batchIndex;
+    }
+    if (batchIndex == mBatches.Size()) {
+      mBatches.Push({InstanceBatch(element.mMeshId)});
+    }
+    Batch& batch = mBatches[batchIndex];
+
+    unsigned int instance = batch.mInstances.Add(
+      element.mTranslation,
+      element.mRotation,
+      element.mScale,
+      element.mMaterialId,
+      element.mVisible);
+    mElementInstances.Push({batchIndex, instance});
+    batch.mBindings.Push({smNoObject});
+    if (element.mVisible) {
+      Bind(&batch, instance);
+    }
+  }
+
+  mLerpGroups.Clear();
+  mLerpInstances.Clear();
+  mLerpStarts.Clear();
+  mLerpEnds.Clear();
+  for (DiscreteEvent& event: mEvents) {
+    event.mLerpGroupsBegin = (unsigned int)mLerpGroups.Size();
+    for (const Track& track: event.mTracks) {
+      if (
+        track.mPhase != Phase::Lerp ||
+        (track.mProperty != Property::Translation &&
+         track.mProperty != Property::Scale)) {
+        continue;
+      }
+      const ElementInstance& elementInstance = mElementInstances[track.mTarget];
+      bool grouped = false;
+      for (size_t g = event.mLerpGroupsBegin; g < mLerpGroups.Size(); ++g) {
+        const LerpGroup& group = mLerpGroups[g];
+        if (
+          group.mBatch == elementInstance.mBatch &&
+          group.mProperty == track.mProperty) {
+          grouped = true;
+          break;
+        }
+      }
+      if (grouped) {
+        continue;
+      }
+
+      // The first track of a group gathers every track of the group so the
+      // group's values are contiguous.
+      LerpGroup group = {
+        elementInstance.mBatch,
+        track.mProperty,
+        (unsigned int)mLerpInstances.Size(),
+        0};
+      for (const Track& member: event.mTracks) {
+        if (
+          member.mPhase != Phase::Lerp || member.mProperty != group.mProperty) {
+          continue;
+        }
+        const ElementInstance& memberInstance =
+          mElementInstances[member.mTarget];
+        if (memberInstance.mBatch == group.mBatch) {
+          mLerpInstances.Push(memberInstance.mInstance);
+          mLerpStarts.Push(Vec3(member.mStart));
+          mLerpEnds.Push(Vec3(member.mEnd));
+          ++group.mCount;
+        }
+      }
+      mLerpGroups.Push(group);
+    }
+    event.mLerpGroupsEnd = (unsigned int)mLerpGroups.Size();
+  }
+}
+
+void Sequence::Bind(Batch* batch, unsigned int instance) {
+  Binding binding;
+  if (batch->mFreeBindings.Empty()) {
+    World::Object object = World::Object(mSpace, mRootId).CreateChild();
+    object.Add<Comp::Mesh>().mMeshId = mStrings[batch->mInstances.mMeshId];
+    binding = {object.mMemberId, smNoMaterial};
+  }
+  else {
+    binding = batch->mFreeBindings.Top();
+    batch->mFreeBindings.Pop();
+  }
+
+  // A recycled object still holds the state of the instance it last presented
+  // so every property is written.
+  const InstanceBatch& instances = batch->mInstances;
+  World::Object object(mSpace, binding.mObject);
+  auto& mesh = object.Get<Comp::Mesh>();
+  if (binding.mMaterialId != instances.mMaterialIds[instance]) {
+    binding.mMaterialId = instances.mMaterialIds[instance];
+    mesh.mMaterialId = mStrings[binding.mMaterialId];
+  }
+  mesh.mVisible = true;
+  auto& transform = object.Get<Comp::Transform>();
+  transform.SetTranslation(instances.mTranslations[instance]);
+  transform.SetRotation(instances.mRotations[instance]);
+  transform.SetScale(instances.mScales[instance]);
+  batch->mBindings[instance] = binding;
+}
+
+void Sequence::Unbind(Batch* batch, unsigned int instance) {
+  Binding& binding = batch->mBindings[instance];
+  World::Object(mSpace, binding.mObject).Get<Comp::Mesh>().mVisible = false;
+  batch->mFreeBindings.Push(binding);
+  binding.mObject = smNoObject;
+}
+
+namespace {
+
+// The layout of a baked sequence file. Every count in the header is followed
+// by that many entries in the order the counts are listed. Strings are a
+// uint32_t length followed by their characters.
+constexpr uint32_t nBakeMagic = 0x51455356; // "VSEQ"
+constexpr uint32_t nBakeVersion = 3;
+
+struct BakeHeader {
+  uint32_t mMagic;
+  uint32_t mVersion;
+  uint64_t mInputHash;
+  float mTotalTime;
+  uint32_t mStringCount;
+  uint32_t mElementCount;
+  uint32_t mUniformCount;
+  uint32_t mEventCount;
+  uint32_t mTrackCount;
+};
+
+struct BakeElement {
+  uint32_t mMeshId;
+  uint32_t mMaterialId;
+  float mTranslation[3];
+  float mRotation[4];
+  float mScale[3];
+  uint32_t mVisible;
+};
+
+struct BakeEvent {
+  uint32_t mName;
+  float mStartTime;
+  float mEndTime;
+  uint32_t mEase;
+  uint32_t mParallel;
+  uint32_t mTrackCount;
+};
+
+struct BakeTrack {
+  uint8_t mPhase;
+  uint8_t mProperty;
+  uint16_t mPadding;
+  uint32_t mTarget;
+  float mStart[4];
+  float mEnd[4];
+};
+
+template<typename T>
+void Write(std::ofstream& file, const T& value) {
+  file.write((const char*)&value, sizeof(T));
+}
+
+// Reads values from a mapped file and fails once the end has been passed.
+struct BakeReader {
+  const char* mCurrent;
+  const char* mEnd;
+  size_t Remaining() const {
+    return (size_t)(mEnd - mCurrent);
+  }
+  template<typename T>
+  bool Read(T* value) {
+    if (Remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(value, mCurrent, sizeof(T));
+    mCurrent += sizeof(T);
+    return true;
+  }
+  bool Read(std::string* string) {
+    uint32_t length;
+    if (!Read(&length) || Remaining() < length) {
+      return false;
+    }
+    string->assign(mCurrent, length);
+    mCurrent += length;
+    return true;
+  }
+};
+
+// Material tracks store string indices in floats, so a valid value is a
+// whole number below the string count.
+bool IsStringIndex(float value, uint32_t stringCount) {
+  return value >= 0.0f && value < (float)stringCount &&
+    value == std::floor(value);
+}
+
+} // namespace
+
+Result Sequence::Bake(const std::string& filename, uint64_t inputHash) const {
+  // Event names are only written to the string table of the file because
+  // they are not part of the sequence's own table.
+  Ds::Vector<std::string> strings = mStrings;
+  std::unordered_map<std::string, unsigned int> stringIds = mStringIds;
+  Ds::Vector<uint32_t> eventNames;
+  size_t trackCount = 0;
+  for (const DiscreteEvent& event: mEvents) {
+    if (event.mBegin || event.mLerp || event.mEnd) {
+      return Result(
+        "Event \"" + event.mName + "\" uses callbacks and cannot be baked.");
+    }
+    auto [entry, added] =
+      stringIds.try_emplace(event.mName, (unsigned int)strings.Size());
+    if (added) {
+      strings.Push(event.mName);
+    }
+    eventNames.Push(entry->second);
+    trackCount += event.mTracks.Size();
+  }
+
+  std::string tempFilename = filename + ".tmp";
+  std::ofstream file(tempFilename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Result("Failed to open \"" + tempFilename + "\".");
+  }
+  BakeHeader header = {
+    nBakeMagic,
+    nBakeVersion,
+    inputHash,
+    mTotalTime,
+    (uint32_t)strings.Size(),
+    (uint32_t)mElements.Size(),
+    (uint32_t)mUniforms.Size(),
+    (uint32_t)mEvents.Size(),
+    (uint32_t)trackCount};
+  Write(file, header);
+  for (const std::string& string: strings) {
+    Write(file, (uint32_t)string.size());
+    file.write(string.data(), string.size());
+  }
+  for (const Element& element: mElements) {
+    BakeElement bakeElement;
+    bakeElement.mMeshId = element.mMeshId;
+    bakeElement.mMaterialId = element.mMaterialId;
+    for (int i = 0; i < 3; ++i) {
+      bakeElement.mTranslation[i] = element.mTranslation[i];
+      bakeElement.mScale[i] = element.mScale[i];
+    }
+    bakeElement.mRotation[0] = element.mRotation.mA;
+    bakeElement.mRotation[1] = element.mRotation.mB;
+    bakeElement.mRotation[2] = element.mRotation.mC;
+    bakeElement.mRotation[3] = element.mRotation.mD;
+    bakeElement.mVisible = element.mVisible;
+    Write(file, bakeElement);
+  }
+  for (const Uniform& uniform: mUniforms) {
+    Write(file, (uint32_t)uniform.mMaterialId);
+    Write(file, (uint32_t)uniform.mName);
+  }
+  for (size_t e = 0; e < mEvents.Size(); ++e) {
+    const DiscreteEvent& event = mEvents[e];
+    BakeEvent bakeEvent = {
+      eventNames[e],
+      event.mStartTime,
+      event.mEndTime,
+      (uint32_t)event.mEase,
+      event.mParallel,
+      (uint32_t)event.mTracks.Size()};
+    Write(file, bakeEvent);
+  }
+  for (const DiscreteEvent& event: mEvents) {
+    for (const Track& track: event.mTracks) {
+      BakeTrack bakeTrack;
+      bakeTrack.mPhase = (uint8_t)track.mPhase;
+      bakeTrack.mProperty = (uint8_t)track.mProperty;
+      bakeTrack.mPadding = 0;
+      bakeTrack.mTarget = track.mTarget;
+      for (int i = 0; i < 4; ++i) {
+        bakeTrack.mStart[i] = track.mStart[i];
+        bakeTrack.mEnd[i] = track.mEnd[i];
+      }
+      Write(file, bakeTrack);
+    }
+  }
+  file.close();
+  if (file.fail()) {
+    return Result("Failed to write \"" + tempFilename + "\".");
+  }
+  std::error_code error;
+  std::filesystem::rename(tempFilename, filename, error);
+  if (error) {
+    return Result("Failed to replace \"" + filename + "\".");
+  }
+  return Result();
+}
+
+Result Sequence::LoadBaked(const std::string& filename, uint64_t inputHash) {
+  VResult<MappedFile> fileResult = MappedFile::Init(filename);
+  if (!fileResult.Success()) {
+    return Result(fileResult.mError);
+  }
+  const MappedFile& file = fileResult.mValue;
+  BakeReader reader = {file.Data(), file.Data() + file.Size()};
+  const std::string corrupt = "\"" + filename + "\" is corrupt.";
+
+  BakeHeader header;
+  if (!reader.Read(&header) || header.mMagic != nBakeMagic) {
+    return Result("\"" + filename + "\" is not a baked sequence.");
+  }
+  if (header.mVersion != nBakeVersion || header.mInputHash != inputHash) {
+    return Result("\"" + filename + "\" is outdated.");
+  }
+
+  // The counts are checked against the size of the file before anything is
+  // allocated for them. Strings take at least their length.
+  uint64_t minimumSize = (uint64_t)header.mStringCount * sizeof(uint32_t) +
+    (uint64_t)header.mElementCount * sizeof(BakeElement) +
+    (uint64_t)header.mUniformCount * 2 * sizeof(uint32_t) +
+    (uint64_t)header.mEventCount * sizeof(BakeEvent) +
+    (uint64_t)header.mTrackCount * sizeof(BakeTrack);
+  if (minimumSize > reader.Remaining()) {
+    return Result(corrupt);
+  }
+
+  // Everything is read into a new sequence so a failed load leaves this
+  // sequence untouched.
+  Sequence baked;
+  baked.mTotalTime = header.mTotalTime;
+  baked.mStrings.Resize(header.mStringCount);
+  for (std::string& string: baked.mStrings) {
+    if (!reader.Read(&string)) {
+      return Result(corrupt);
+    }
+  }
+  for (uint32_t i = 0; i < header.mElementCount; ++i) {
+    BakeElement bakeElement;
+    if (
+      !reader.Read(&bakeElement) ||
+      bakeElement.mMeshId >= header.mStringCount ||
+      bakeElement.mMaterialId >= header.mStringCount) {
+      return Result(corrupt);
+    }
+    Element element;
+    element.mMeshId = bakeElement.mMeshId;
+    element.mMaterialId = bakeElement.mMaterialId;
+    for (int i = 0; i < 3; ++i) {
+      element.mTranslation[i] = bakeElement.mTranslation[i];
+      element.mScale[i] = bakeElement.mScale[i];
+    }
+    element.mRotation.mA = bakeElement.mRotation[0];
+    element.mRotation.mB = bakeElement.mRotation[1];
+    element.mRotation.mC = bakeElement.mRotation[2];
+    element.mRotation.mD = bakeElement.mRotation[3];
+    element.mVisible = bakeElement.mVisible != 0;
+    baked.mElements.Push(element);
+  }
+  for (uint32_t i = 0; i < header.mUniformCount; ++i) {
+    uint32_t materialId, name;
+    if (
+      !reader.Read(&materialId) || !reader.Read(&name) ||
+      materialId >= header.mStringCount || name >= header.mStringCount) {
+      return Result(corrupt);
+    }
+    baked.mUniforms.Push({materialId, name});
+  }
+  // Events must be ordered by their start times like AddDiscreteEvent keeps
+  // them and their tracks must add up to the header's track count.
+  Ds::Vector<uint32_t> eventTrackCounts;
+  uint64_t trackCount = 0;
+  baked.mEvents.Resize(header.mEventCount);
+  for (size_t e = 0; e < baked.mEvents.Size(); ++e) {
+    DiscreteEvent& event = baked.mEvents[e];
+    BakeEvent bakeEvent;
+    if (
+      !reader.Read(&bakeEvent) || bakeEvent.mName >= header.mStringCount ||
+      bakeEvent.mEase > (uint32_t)EaseType::Flash ||
+      !(bakeEvent.mStartTime <= bakeEvent.mEndTime) ||
+      (e > 0 && !(baked.mEvents[e - 1].mStartTime <= bakeEvent.mStartTime))) {
+      return Result(corrupt);
+    }
+    trackCount += bakeEvent.mTrackCount;
+    event.mName = baked.mStrings[bakeEvent.mName];
+    event.mStartTime = bakeEvent.mStartTime;
+    event.mEndTime = bakeEvent.mEndTime;
+    event.mEase = (EaseType)bakeEvent.mEase;
+    event.mParallel = bakeEvent.mParallel != 0;
+    eventTrackCounts.Push(bakeEvent.mTrackCount);
+  }
+  if (trackCount != header.mTrackCount) {
+    return Result(corrupt);
+  }
+  for (size_t e = 0; e < baked.mEvents.Size(); ++e) {
+    DiscreteEvent& event = baked.mEvents[e];
+    event.mTracks.Reserve(eventTrackCounts[e]);
+    for (uint32_t t = 0; t < eventTrackCounts[e]; ++t) {
+      BakeTrack bakeTrack;
+      if (
+        !reader.Read(&bakeTrack) || bakeTrack.mPhase > (uint8_t)Phase::End ||
+        bakeTrack.mProperty > (uint8_t)Property::Rotation) {
+        return Result(corrupt);
+      }
+      Track track;
+      uint32_t targetCount = header.mElementCount;
+      if (bakeTrack.mProperty == (uint8_t)Property::Color) {
+        targetCount = header.mUniformCount;
+      }
+      if (
+        bakeTrack.mProperty != (uint8_t)Property::Orbit &&
+        bakeTrack.mTarget >= targetCount) {
+        return Result(corrupt);
+      }
+      if (
+        bakeTrack.mProperty == (uint8_t)Property::Material &&
+        (!IsStringIndex(bakeTrack.mStart[0], header.mStringCount) ||
+         !IsStringIndex(bakeTrack.mEnd[0], header.mStringCount))) {
+        return Result(corrupt);
+      }
+      track.mPhase = (Phase)bakeTrack.mPhase;
+      track.mProperty = (Property)bakeTrack.mProperty;
+      track.mTarget = bakeTrack.mTarget;
+      for (int i = 0; i < 4; ++i) {
+        track.mStart[i] = bakeTrack.mStart[i];
+        track.mEnd[i] = bakeTrack.mEnd[i];
+      }
+      event.mTracks.Push(track);
+    }
+  }
+  if (reader.Remaining() != 0) {
+    return Result(corrupt);
+  }
+
+  mTotalTime = baked.mTotalTime;
+  mEvents = std::move(baked.mEvents);
+  mStrings = std::move(baked.mStrings);
+  mStringIds.clear();
+  for (unsigned int i = 0; i < mStrings.Size(); ++i) {
+    mStringIds.emplace(mStrings[i], i);
+  }
+  mElements = std::move(baked.mElements);
+  mUniforms = std::move(baked.mUniforms);
+  return Result();
+}
+
 bool Sequence::AtEnd() {
   return mNextInactiveEvent == mEvents.Size() && mActiveEvents.Size() == 0;
 }
@@ -107,6 +703,8 @@ void Sequence::Update(float dt) {
 
 void Sequence::ScrubUp(float scrubTime) {
   Assert(scrubTime > mTimePassed);
+  int64_t frameStart = ProfileTime();
+  size_t firstSample = mProfileSamples.Size();
 
   // Activate any events that haven't started.
   while (mNextInactiveEvent < mEvents.Size()) {
@@ -123,21 +721,24 @@ void Sequence::ScrubUp(float scrubTime) {
   for (int i = 0; i < mActiveEvents.Size(); ++i) {
     const DiscreteEvent& event = mEvents[mActiveEvents[i]];
     if (mTimePassed <= event.mStartTime) {
-      if (event.mBegin) event.mBegin(Cross::In);
+      Begin(event, Cross::In);
     }
     if (scrubTime >= event.mEndTime) {
-      if (event.mLerp) event.mLerp(1.0f);
-      if (event.mEnd) event.mEnd(Cross::Out);
+      Lerp(event, 1.0f);
+      End(event, Cross::Out);
     }
     else {
       float eventDuration = event.mEndTime - event.mStartTime;
       float passedDuration = scrubTime - event.mStartTime;
       float t = passedDuration / eventDuration;
-      event.Run(t);
+      Run(event, t);
       remainingActiveEvents.Push(mActiveEvents[i]);
     }
   }
   mActiveEvents = std::move(remainingActiveEvents);
+  RunDeferredLerps();
+  Present();
+  RecordFrame(frameStart, firstSample);
 
   if (AtEnd()) {
     mTimePassed = mTotalTime;
@@ -149,6 +750,8 @@ void Sequence::ScrubUp(float scrubTime) {
 
 void Sequence::ScrubDown(float scrubTime) {
   Assert(scrubTime < mTimePassed);
+  int64_t frameStart = ProfileTime();
+  size_t firstSample = mProfileSamples.Size();
 
   // Collect events that must be handled.
   mActiveEvents.Clear();
@@ -168,21 +771,24 @@ void Sequence::ScrubDown(float scrubTime) {
   for (int i = 0; i < mActiveEvents.Size(); ++i) {
     const DiscreteEvent& event = mEvents[mActiveEvents[i]];
     if (mTimePassed >= event.mEndTime) {
-      if (event.mEnd) event.mEnd(Cross::In);
+      End(event, Cross::In);
     }
     if (scrubTime <= event.mStartTime) {
-      if (event.mLerp) event.mLerp(0.0f);
-      if (event.mBegin) event.mBegin(Cross::Out);
+      Lerp(event, 0.0f);
+      Begin(event, Cross::Out);
     }
     else {
       float eventDuration = event.mEndTime - event.mStartTime;
       float passedDuration = scrubTime - event.mStartTime;
       float t = passedDuration / eventDuration;
-      event.Run(t);
+      Run(event, t);
       remainingActiveEvents.Push(mActiveEvents[i]);
     }
   }
   mActiveEvents = std::move(remainingActiveEvents);
+  RunDeferredLerps();
+  Present();
+  RecordFrame(frameStart, firstSample);
 
   if (scrubTime < 0.0f) {
     mTimePassed = 0.0f;
@@ -200,3 +806,407 @@ void Sequence::Scrub(float time) {
     ScrubDown(time);
   }
 }
+
+void Sequence::Begin(const DiscreteEvent& event, Cross dir) {
+  int64_t start = ProfileTime();
+  if (event.mBegin) event.mBegin(dir);
+  for (const Track& track: event.mTracks) {
+    if (track.mPhase == Phase::Begin) {
+      Apply(track, dir == Cross::In ? track.mEnd : track.mStart);
+    }
+  }
+  RecordSample(EventIndex(event), Stage::Begin, start);
+}
+
+void Sequence::Lerp(const DiscreteEvent& event, float t) {
+  int64_t start = ProfileTime();
+  for (unsigned int g = event.mLerpGroupsBegin; g < event.mLerpGroupsEnd; ++g) {
+    const LerpGroup& group = mLerpGroups[g];
+    LerpGroupValues(group, 0, group.mCount, t);
+    FlagLerpGroup(group);
+  }
+  LerpTracks(event, t);
+  RecordSample(EventIndex(event), Stage::Lerp, start);
+}
+
+void Sequence::LerpTracks(const DiscreteEvent& event, float t) {
+  if (event.mLerp) event.mLerp(t);
+  for (const Track& track: event.mTracks) {
+    // Translation and Scale lerps are handled by the lerp groups.
+    if (
+      track.mPhase != Phase::Lerp || track.mProperty == Property::Translation ||
+      track.mProperty == Property::Scale) {
+      continue;
+    }
+    if (track.mProperty == Property::Orbit) {
+      const Vec4& c = track.mStart;
+      Apply(track, {c[0] + t * (c[1] + t * (c[2] + t * c[3])), 0, 0, 0});
+    }
+    else if (track.mProperty == Property::Rotation) {
+      Vec4 end = track.mEnd;
+      if (Math::Dot(track.mStart, end) < 0.0f) {
+        end *= -1.0f;
+      }
+      Apply(track, Math::Normalize(Math::Lerp(track.mStart, end, t)));
+    }
+    else {
+      Apply(track, Math::Lerp(track.mStart, track.mEnd, t));
+    }
+  }
+}
+
+void Sequence::LerpGroupValues(
+  const LerpGroup& group, unsigned int first, unsigned int count, float t) {
+  InstanceBatch& instances = mBatches[group.mBatch].mInstances;
+  first += group.mFirst;
+  const unsigned int* targets = mLerpInstances.CData() + first;
+  const Vec3* starts = mLerpStarts.CData() + first;
+  const Vec3* ends = mLerpEnds.CData() + first;
+  if (group.mProperty == Property::Translation) {
+    instances.LerpTranslations(targets, starts, ends, count, t);
+  }
+  else {
+    instances.LerpScales(targets, starts, ends, count, t);
+  }
+}
+
+void Sequence::FlagLerpGroup(const LerpGroup& group) {
+  InstanceBatch::Change change = group.mProperty == Property::Translation
+    ? InstanceBatch::Translation
+    : InstanceBatch::Scale;
+  mBatches[group.mBatch].mInstances.Flag(
+    mLerpInstances.CData() + group.mFirst, group.mCount, change);
+}
+
+namespace {
+
+// Deferred lerps are only spread over the worker pool when a scrub has at
+// least this many values to interpolate, and they are split into jobs of at
+// most nLerpJobSize values. A value takes about 4ns to lerp, so fewer values
+// finish in a few microseconds, which is less than handing them to other
+// threads and waiting for them costs. The heaviest frames of the QuickHull
+// video defer 505 values and stay on the calling thread.
+constexpr size_t nParallelLerpMinimum = 4096;
+constexpr unsigned int nLerpJobSize = 1024;
+
+} // namespace
+
+void Sequence::RunDeferredLerps() {
+  if (mDeferredLerps.Empty()) {
+    return;
+  }
+  int64_t start = ProfileTime();
+  size_t valueCount = 0;
+  for (const DeferredLerp& deferred: mDeferredLerps) {
+    valueCount += mLerpGroups[deferred.mGroup].mCount;
+  }
+  if (valueCount < nParallelLerpMinimum) {
+    for (const DeferredLerp& deferred: mDeferredLerps) {
+      const LerpGroup& group = mLerpGroups[deferred.mGroup];
+      LerpGroupValues(group, 0, group.mCount, deferred.mT);
+    }
+  }
+  else {
+    if (!mPool) {
+      mPool = std::make_unique<WorkerPool>();
+    }
+    for (const DeferredLerp& deferred: mDeferredLerps) {
+      const LerpGroup& group = mLerpGroups[deferred.mGroup];
+      for (unsigned int first = 0; first < group.mCount;
+           first += nLerpJobSize) {
+        unsigned int count = std::min(nLerpJobSize, group.mCount - first);
+        float t = deferred.mT;
+        mPool->Enqueue([this, &group, first, count, t]() {
+          LerpGroupValues(group, first, count, t);
+        });
+      }
+    }
+    mPool->Wait();
+  }
+
+  // Flagging appends to a batch's changed instances, so it stays on this
+  // thread.
+  for (const DeferredLerp& deferred: mDeferredLerps) {
+    FlagLerpGroup(mLerpGroups[deferred.mGroup]);
+  }
+  mDeferredLerps.Clear();
+  RecordSample(smNoEvent, Stage::DeferredLerps, start);
+}
+
+void Sequence::End(const DiscreteEvent& event, Cross dir) {
+  int64_t start = ProfileTime();
+  if (event.mEnd) event.mEnd(dir);
+  for (const Track& track: event.mTracks) {
+    if (track.mPhase == Phase::End) {
+      Apply(track, dir == Cross::Out ? track.mEnd : track.mStart);
+    }
+  }
+  RecordSample(EventIndex(event), Stage::End, start);
+}
+
+void Sequence::Run(const DiscreteEvent& event, float t) {
+  t = Ease(t, event.mEase);
+  if (!event.mParallel) {
+    Lerp(event, t);
+    return;
+  }
+  int64_t start = ProfileTime();
+  for (unsigned int g = event.mLerpGroupsBegin; g < event.mLerpGroupsEnd; ++g) {
+    mDeferredLerps.Push({g, t});
+  }
+  LerpTracks(event, t);
+  RecordSample(EventIndex(event), Stage::Lerp, start);
+}
+
+void Sequence::Apply(const Track& track, const Vec4& value) {
+  if (track.mProperty == Property::Color) {
+    UniformState& state = mUniformStates[track.mTarget];
+    state.mValue = value;
+    if (!state.mStaged) {
+      state.mStaged = true;
+      mStagedUniforms.Push(track.mTarget);
+    }
+    return;
+  }
+  if (track.mProperty == Property::Orbit) {
+    // The orbit's angle is passed in the first component of the value.
+    World::Object camera(mSpace, mCameraId);
+    float theta = value[0];
+    float distance = track.mEnd[0];
+    camera.Get<Comp::Transform>().SetTranslation(
+      {std::sinf(theta) * distance, 0.0f, std::cosf(theta) * distance});
+    camera.Get<Comp::Camera>().WorldLookAt({0, 0, 0}, {0, 1, 0}, camera);
+    return;
+  }
+
+  const ElementInstance& elementInstance = mElementInstances[track.mTarget];
+  InstanceBatch& instances = mBatches[elementInstance.mBatch].mInstances;
+  unsigned int instance = elementInstance.mInstance;
+  switch (track.mProperty) {
+  case Property::Visible:
+    instances.SetVisible(instance, value[0] != 0.0f);
+    break;
+  case Property::Material:
+    instances.SetMaterial(instance, (unsigned int)value[0]);
+    break;
+  case Property::Translation:
+    instances.SetTranslation(instance, Vec3(value));
+    break;
+  case Property::Scale: instances.SetScale(instance, Vec3(value)); break;
+  case Property::Rotation: {
+    Quat rotation;
+    rotation.mA = value[0];
+    rotation.mB = value[1];
+    rotation.mC = value[2];
+    rotation.mD = value[3];
+    instances.SetRotation(instance, rotation);
+    break;
+  }
+  default: break;
+  }
+}
+
+void Sequence::Present() {
+  int64_t start = ProfileTime();
+  PresentUniforms();
+  for (Batch& batch: mBatches) {
+    const InstanceBatch& instances = batch.mInstances;
+    batch.mInstances.VisitChanges([&](unsigned int instance, uint8_t changes) {
+      Binding& binding = batch.mBindings[instance];
+      if (!instances.mVisible[instance]) {
+        if (binding.mObject != smNoObject) {
+          Unbind(&batch, instance);
+        }
+        return;
+      }
+      if (binding.mObject == smNoObject) {
+        Bind(&batch, instance);
+        return;
+      }
+
+      World::Object object(mSpace, binding.mObject);
+      unsigned int materialId = instances.mMaterialIds[instance];
+      if (
+        (changes & InstanceBatch::Material) &&
+        binding.mMaterialId != materialId) {
+        binding.mMaterialId = materialId;
+        object.Get<Comp::Mesh>().mMaterialId = mStrings[materialId];
+      }
+      if (changes & (InstanceBatch::Translation | InstanceBatch::Scale)) {
+        auto& transform = object.Get<Comp::Transform>();
+        transform.SetTranslation(instances.mTranslations[instance]);
+        transform.SetScale(instances.mScales[instance]);
+      }
+      if (changes & InstanceBatch::Rotation) {
+        object.Get<Comp::Transform>().SetRotation(
+          instances.mRotations[instance]);
+      }
+    });
+  }
+  RecordSample(smNoEvent, Stage::Present, start);
+}
+
+void Sequence::PresentUniforms() {
+  mUniformWrites = 0;
+  for (unsigned int uniformIndex: mStagedUniforms) {
+    UniformState& state = mUniformStates[uniformIndex];
+    state.mStaged = false;
+    if (state.mPresented && state.mPresentedValue == state.mValue) {
+      continue;
+    }
+    const Uniform& uniform = mUniforms[uniformIndex];
+    Rsl::GetRes<Gfx::Material>(mStrings[uniform.mMaterialId])
+      .Get<Vec4>(mStrings[uniform.mName]) = state.mValue;
+    state.mPresentedValue = state.mValue;
+    state.mPresented = true;
+    ++mUniformWrites;
+  }
+  mStagedUniforms.Clear();
+}
+
+void Sequence::ClearProfile() {
+  mProfileSamples.Clear();
+  mProfileFrames.Clear();
+  mEventTotals.Clear();
+  mProfileEpoch = std::chrono::steady_clock::now();
+}
+
+Ds::Vector<Sequence::ProfiledEvent> Sequence::ProfiledEvents(
+  size_t count) const {
+  std::unordered_map<std::string, size_t> eventIndices;
+  Ds::Vector<ProfiledEvent> events;
+  for (size_t e = 0; e < mEventTotals.Size(); ++e) {
+    const ProfileTotals& totals = mEventTotals[e];
+    if (totals.mCalls == 0) {
+      continue;
+    }
+    auto [entry, added] =
+      eventIndices.try_emplace(mEvents[e].mName, events.Size());
+    if (added) {
+      events.Push({mEvents[e].mName, totals});
+      continue;
+    }
+    ProfileTotals& combined = events[entry->second].mTotals;
+    combined.mCalls += totals.mCalls;
+    combined.mTime += totals.mTime;
+    combined.mMaxTime = std::max(combined.mMaxTime, totals.mMaxTime);
+  }
+  std::sort(
+    events.Data(),
+    events.Data() + events.Size(),
+    [](const ProfiledEvent& a, const ProfiledEvent& b) {
+      return a.mTotals.mTime > b.mTotals.mTime;
+    });
+  if (events.Size() > count) {
+    events.Resize(count);
+  }
+  return events;
+}
+
+namespace {
+
+const char* nStageNames[] = {
+  "Begin", "Lerp", "End", "DeferredLerps", "Present"};
+
+// Writes a complete event of a Chrome trace. Times are converted from
+// nanoseconds to the microseconds the format uses.
+void WriteTraceEvent(
+  std::ofstream& file,
+  const std::string& name,
+  const char* category,
+  int64_t start,
+  int64_t duration) {
+  file << ",\n{\"name\":\"";
+  for (char c: name) {
+    if (c == '"' || c == '\\') {
+      file << '\\';
+    }
+    file << c;
+  }
+  file << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0";
+  file << ",\"ts\":" << start / 1000.0 << ",\"dur\":" << duration / 1000.0;
+  file << "}";
+}
+
+} // namespace
+
+Result Sequence::WriteProfileTrace(const std::string& filename) const {
+  std::string tempFilename = filename + ".tmp";
+  std::ofstream file(tempFilename, std::ios::trunc);
+  if (!file.is_open()) {
+    return Result("Failed to open \"" + tempFilename + "\".");
+  }
+  file << std::fixed;
+  file.precision(3);
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+       << "\"args\":{\"name\":\"Sequence\"}}";
+  for (const ProfileFrame& frame: mProfileFrames) {
+    WriteTraceEvent(file, "Scrub", "Frame", frame.mStart, frame.mDuration);
+    size_t end = frame.mFirstSample + frame.mSampleCount;
+    for (size_t i = frame.mFirstSample; i < end; ++i) {
+      const ProfileSample& sample = mProfileSamples[i];
+      const char* stageName = nStageNames[(int)sample.mStage];
+      WriteTraceEvent(
+        file,
+        sample.mEvent == smNoEvent ? stageName : mEvents[sample.mEvent].mName,
+        stageName,
+        sample.mStart,
+        sample.mDuration);
+    }
+  }
+  file << "\n]}\n";
+  file.close();
+  if (file.fail()) {
+    return Result("Failed to write \"" + tempFilename + "\".");
+  }
+  std::error_code error;
+  std::filesystem::rename(tempFilename, filename, error);
+  if (error) {
+    return Result("Failed to replace \"" + filename + "\".");
+  }
+  return Result();
+}
+
+unsigned int Sequence::EventIndex(const DiscreteEvent& event) const {
+  return (unsigned int)(&event - mEvents.CData());
+}
+
+int64_t Sequence::ProfileTime() const {
+  if (!mProfiling) {
+    return 0;
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now() - mProfileEpoch)
+    .count();
+}
+
+void Sequence::RecordSample(unsigned int event, Stage stage, int64_t start) {
+  if (!mProfiling) {
+    return;
+  }
+  int64_t duration = ProfileTime() - start;
+  if (event != smNoEvent) {
+    if (mEventTotals.Size() != mEvents.Size()) {
+      mEventTotals.Resize(mEvents.Size(), {0, 0, 0});
+    }
+    ProfileTotals& totals = mEventTotals[event];
+    ++totals.mCalls;
+    totals.mTime += duration;
+    totals.mMaxTime = std::max(totals.mMaxTime, duration);
+  }
+  if (mProfileSamples.Size() < smMaxProfileSamples) {
+    mProfileSamples.Push({event, stage, start, duration});
+  }
+}
+
+void Sequence::RecordFrame(int64_t start, size_t firstSample) {
+  if (!mProfiling) {
+    return;
+  }
+  mProfileFrames.Push(
+    {start,
+     ProfileTime() - start,
+     firstSample,
+     mProfileSamples.Size() - firstSample});
+}
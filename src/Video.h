@@ -1,11 +1,21 @@
 #ifndef Video_h
 #define Video_h
 
+#include <Result.h>
+#include <chrono>
 #include <ds/Vector.h>
 #include <functional>
+#include <math/Quaternion.h>
+#include <math/Vector.h>
+#include <memory>
+#include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <world/World.h>
 
+#include "InstanceBatch.h"
+#include "WorkerPool.h"
+
 template<typename T>
 T Interpolate(const T& start, const T& end, float t) {
   return (1.0f - t) * start + t * end;
@@ -30,31 +40,150 @@ struct Sequence {
     Out,
   };
 
+  // Elements are the objects a sequence creates and animates with tracks.
+  // Their resources are indices into the sequence's string table. Elements
+  // that share a mesh become instances of the same batch once instantiated.
+  struct Element {
+    unsigned int mMeshId;
+    unsigned int mMaterialId;
+    Vec3 mTranslation;
+    Quat mRotation;
+    Vec3 mScale;
+    bool mVisible;
+  };
+
+  // A material uniform that tracks can write to.
+  struct Uniform {
+    unsigned int mMaterialId;
+    unsigned int mName;
+  };
+
+  // Values are stored in the components of a Vec4. Visible uses 0 and 1 and
+  // Material uses an index into the string table. Orbit moves the sequence's
+  // camera around the origin. Its start holds the coefficients of a cubic
+  // polynomial in t giving the angle and its end holds the distance.
+  // Rotation holds the a, b, c, and d components of a quaternion and is
+  // interpolated along the shorter arc.
+  enum class Property : unsigned char {
+    Visible,
+    Material,
+    Translation,
+    Scale,
+    Color,
+    Orbit,
+    Rotation,
+  };
+
+  // Begin and End tracks are steps applied when an event boundary is crossed.
+  // They apply their start value when it is crossed backwards and their end
+  // value when it is crossed forwards. Lerp tracks interpolate between the two
+  // values using the event's ease.
+  enum class Phase : unsigned char {
+    Begin,
+    Lerp,
+    End,
+  };
+
+  struct Track {
+    Phase mPhase;
+    Property mProperty;
+    // An index into the elements or, for Color, the uniforms.
+    unsigned int mTarget;
+    Vec4 mStart;
+    Vec4 mEnd;
+  };
+
+  // The Translation and Scale lerp tracks of an event that target the same
+  // batch. When the sequence is instantiated, the instances, starts, and ends
+  // of every group are placed in one range of the sequence's lerp arrays so
+  // the lerps of all events are evaluated from contiguous memory.
+  struct LerpGroup {
+    unsigned int mBatch;
+    Property mProperty;
+    unsigned int mFirst;
+    unsigned int mCount;
+  };
+
   struct DiscreteEvent {
     std::string mName;
     float mStartTime;
     float mEndTime;
     EaseType mEase;
+    // Declares that the element lerps of the event write to elements no other
+    // event active at the same time writes to. They are then evaluated on
+    // worker threads once all events of a scrub have been handled.
+    bool mParallel = false;
     std::function<void(Cross dir)> mBegin;
     std::function<void(float t)> mLerp;
     std::function<void(Cross dir)> mEnd;
-    void Run(float t) const;
+    Ds::Vector<Track> mTracks;
+    // The range of the sequence's lerp groups that belong to this event.
+    unsigned int mLerpGroupsBegin = 0;
+    unsigned int mLerpGroupsEnd = 0;
+
+    void StepVisible(
+      Phase phase, unsigned int element, bool before, bool after);
+    void StepMaterial(
+      Phase phase,
+      unsigned int element,
+      unsigned int before,
+      unsigned int after);
+    void StepTranslation(
+      Phase phase, unsigned int element, const Vec3& before, const Vec3& after);
+    void StepScale(
+      Phase phase, unsigned int element, const Vec3& before, const Vec3& after);
+    void StepRotation(
+      Phase phase, unsigned int element, const Quat& before, const Quat& after);
+    void StepColor(
+      Phase phase, unsigned int uniform, const Vec4& before, const Vec4& after);
+    void LerpTranslation(
+      unsigned int element, const Vec3& start, const Vec3& end);
+    void LerpScale(unsigned int element, const Vec3& start, const Vec3& end);
+    void LerpRotation(
+      unsigned int element, const Quat& start, const Quat& end);
+    void LerpColor(unsigned int uniform, const Vec4& start, const Vec4& end);
+    void LerpOrbit(const Vec4& coefficients, float distance);
   };
 
   struct ContinuousEvent {
     std::string mName;
     float mDuration;
     EaseType mEase;
+    // See DiscreteEvent::mParallel.
+    bool mParallel = false;
     std::function<void(Cross dir)> mBegin;
     std::function<void(float t)> mLerp;
     std::function<void(Cross dir)> mEnd;
   };
 
-  void AddDiscreteEvent(const DiscreteEvent& event);
-  void AddContinuousEvent(const ContinuousEvent& event);
+  DiscreteEvent& AddDiscreteEvent(const DiscreteEvent& event);
+  DiscreteEvent& AddContinuousEvent(const ContinuousEvent& event);
   void Gap(float duration);
   void Wait();
 
+  // Returns the handle of a string, adding it to mStrings when it is new.
+  unsigned int AddString(const std::string& string);
+  unsigned int AddElement(
+    const std::string& meshId,
+    const std::string& materialId,
+    const Vec3& translation,
+    const Quat& rotation,
+    const Vec3& scale,
+    bool visible);
+  unsigned int AddUniform(
+    const std::string& materialId, const std::string& name);
+  // Creates the objects for all elements and groups the lerp tracks of every
+  // event by batch. This must happen once all elements and events have been
+  // added and before the sequence is played.
+  void Instantiate(World::Space* space, World::MemberId cameraId);
+
+  // A baked sequence stores everything needed to play it without running the
+  // code that generated it. Only sequences without callbacks can be baked. The
+  // input hash identifies the generator inputs and a baked sequence is only
+  // loaded when the given hash matches the one it was baked with.
+  Result Bake(const std::string& filename, uint64_t inputHash) const;
+  Result LoadBaked(const std::string& filename, uint64_t inputHash);
+
   void Play();
   void Pause();
   bool AtEnd();
@@ -70,6 +199,143 @@ struct Sequence {
   unsigned int mNextInactiveEvent;
   Ds::Vector<DiscreteEvent> mEvents;
   Ds::Vector<unsigned int> mActiveEvents;
+
+  // Resources and names are interned in mStrings and referred to by their
+  // index everywhere else. mStringIds finds the index of a string.
+  Ds::Vector<std::string> mStrings;
+  std::unordered_map<std::string, unsigned int> mStringIds;
+  Ds::Vector<Element> mElements;
+  Ds::Vector<Uniform> mUniforms;
+  World::Space* mSpace;
+  World::MemberId mCameraId;
+  // The parent of every element object.
+  World::MemberId mRootId;
+
+  // Tracks write to the batches and the objects presenting the instances are
+  // only updated once at the end of a scrub. Only visible instances are bound
+  // to an object. A hidden instance returns its object to the batch's free
+  // objects for the next instance that appears, so the number of objects
+  // follows the number of visible elements rather than all elements.
+  // Bindings remember the material handle an object's mesh was last given so
+  // the material string is only assigned when the handle actually changes.
+  struct Binding {
+    World::MemberId mObject;
+    unsigned int mMaterialId;
+  };
+  struct Batch {
+    InstanceBatch mInstances;
+    // The binding of each instance. Its object is smNoObject when the
+    // instance is hidden.
+    Ds::Vector<Binding> mBindings;
+    Ds::Vector<Binding> mFreeBindings;
+  };
+  static constexpr World::MemberId smNoObject = (World::MemberId)-1;
+  static constexpr unsigned int smNoMaterial = (unsigned int)-1;
+  struct ElementInstance {
+    unsigned int mBatch;
+    unsigned int mInstance;
+  };
+  Ds::Vector<Batch> mBatches;
+  Ds::Vector<ElementInstance> mElementInstances;
+  Ds::Vector<LerpGroup> mLerpGroups;
+  Ds::Vector<unsigned int> mLerpInstances;
+  Ds::Vector<Vec3> mLerpStarts;
+  Ds::Vector<Vec3> mLerpEnds;
+
+  // The lerp groups of parallel events waiting for the end of a scrub and the
+  // eased time to evaluate them at.
+  struct DeferredLerp {
+    unsigned int mGroup;
+    float mT;
+  };
+  Ds::Vector<DeferredLerp> mDeferredLerps;
+  // Created once the deferred lerps of a scrub are numerous enough to split.
+  std::unique_ptr<WorkerPool> mPool;
+
+  // Color tracks only stage the value of their uniform. Present writes the
+  // final value of every staged uniform to its material once, and only when
+  // it differs from the value that was last written.
+  struct UniformState {
+    Vec4 mValue;
+    Vec4 mPresentedValue;
+    bool mStaged;
+    bool mPresented;
+  };
+  Ds::Vector<UniformState> mUniformStates;
+  Ds::Vector<unsigned int> mStagedUniforms;
+  // The number of uniforms the last Present wrote to materials.
+  unsigned int mUniformWrites;
+
+  // While mProfiling is set, every scrub records a frame holding the wall
+  // time of the begin, lerp, and end work of each event it handles. Times are
+  // nanoseconds since the profile was cleared. Samples stop being kept once
+  // smMaxProfileSamples is reached, but the per event totals keep counting.
+  enum class Stage : unsigned char {
+    Begin,
+    Lerp,
+    End,
+    DeferredLerps,
+    Present,
+  };
+  struct ProfileSample {
+    // An index into mEvents or smNoEvent for work not done for one event.
+    unsigned int mEvent;
+    Stage mStage;
+    int64_t mStart;
+    int64_t mDuration;
+  };
+  struct ProfileFrame {
+    int64_t mStart;
+    int64_t mDuration;
+    size_t mFirstSample;
+    size_t mSampleCount;
+  };
+  struct ProfileTotals {
+    size_t mCalls;
+    int64_t mTime;
+    int64_t mMaxTime;
+  };
+  struct ProfiledEvent {
+    std::string mName;
+    ProfileTotals mTotals;
+  };
+  static constexpr unsigned int smNoEvent = (unsigned int)-1;
+  static constexpr size_t smMaxProfileSamples = 1 << 20;
+  bool mProfiling;
+  Ds::Vector<ProfileSample> mProfileSamples;
+  Ds::Vector<ProfileFrame> mProfileFrames;
+
+  void ClearProfile();
+  // The totals of the count events that took the longest, where events with
+  // the same name are combined.
+  Ds::Vector<ProfiledEvent> ProfiledEvents(size_t count) const;
+  // Writes the recorded frames and samples in the Chrome trace event format.
+  Result WriteProfileTrace(const std::string& filename) const;
+
+private:
+  void Begin(const DiscreteEvent& event, Cross dir);
+  void Lerp(const DiscreteEvent& event, float t);
+  void End(const DiscreteEvent& event, Cross dir);
+  void Run(const DiscreteEvent& event, float t);
+  void LerpTracks(const DiscreteEvent& event, float t);
+  void LerpGroupValues(
+    const LerpGroup& group, unsigned int first, unsigned int count, float t);
+  void FlagLerpGroup(const LerpGroup& group);
+  void RunDeferredLerps();
+  void Apply(const Track& track, const Vec4& value);
+  void Present();
+  void Bind(Batch* batch, unsigned int instance);
+  void Unbind(Batch* batch, unsigned int instance);
+  void PresentUniforms();
+
+  unsigned int EventIndex(const DiscreteEvent& event) const;
+  int64_t ProfileTime() const;
+  void RecordSample(unsigned int event, Stage stage, int64_t start);
+  void RecordFrame(int64_t start, size_t firstSample);
+
+  std::chrono::steady_clock::time_point mProfileEpoch;
+  // The calls, total time, and max time of every event, indexed like mEvents.
+  Ds::Vector<ProfileTotals> mEventTotals;
 };
 
 struct Video {
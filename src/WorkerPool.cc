@@ -0,0 +1,124 @@
+#include "WorkerPool.h"
+
+namespace {
+
+// The pool and queue of the pool thread running on the current thread.
+thread_local const WorkerPool* tPool = nullptr;
+thread_local unsigned int tQueue = 0;
+
+} // namespace
+
+WorkerPool::WorkerPool(unsigned int threadCount):
+  mNextQueue(0), mQueuedJobs(0), mUnfinishedJobs(0), mStopping(false) {
+  if (threadCount == 0) {
+    threadCount = std::thread::hardware_concurrency();
+  }
+  if (threadCount == 0) {
+    threadCount = 1;
+  }
+  mQueueCount = threadCount;
+  mQueues = std::make_unique<Queue[]>(threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i) {
+    mThreads.Emplace(&WorkerPool::Work, this, i);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mJobQueued.notify_all();
+  for (std::thread& thread: mThreads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Enqueue(std::function<void()> job) {
+  unsigned int queue = tQueue;
+  if (tPool != this) {
+    queue = mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueueCount;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mQueues[queue].mMutex);
+    mQueues[queue].mJobs.push_back(std::move(job));
+  }
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    ++mQueuedJobs;
+    ++mUnfinishedJobs;
+  }
+  mJobQueued.notify_one();
+}
+
+void WorkerPool::Wait() {
+  unsigned int queue = tPool == this ? tQueue : smNoQueue;
+  std::function<void()> job;
+  while (Take(queue, &job)) {
+    Run(job);
+  }
+  std::unique_lock<std::mutex> lock(mMutex);
+  mJobsFinished.wait(lock, [this]() {
+    return mUnfinishedJobs == 0;
+  });
+}
+
+size_t WorkerPool::ThreadCount() const {
+  return mThreads.Size();
+}
+
+void WorkerPool::Work(unsigned int queue) {
+  tPool = this;
+  tQueue = queue;
+  std::function<void()> job;
+  while (true) {
+    if (Take(queue, &job)) {
+      Run(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJobQueued.wait(lock, [this]() {
+      return mStopping || mQueuedJobs > 0;
+    });
+    if (mStopping && mQueuedJobs <= 0) {
+      return;
+    }
+  }
+}
+
+bool WorkerPool::Take(unsigned int queue, std::function<void()>* job) {
+  if (queue != smNoQueue) {
+    Queue& own = mQueues[queue];
+    std::unique_lock<std::mutex> lock(own.mMutex);
+    if (!own.mJobs.empty()) {
+      *job = std::move(own.mJobs.back());
+      own.mJobs.pop_back();
+      return true;
+    }
+  }
+  unsigned int start = queue == smNoQueue ? 0 : queue + 1;
+  for (unsigned int i = 0; i < mQueueCount; ++i) {
+    Queue& other = mQueues[(start + i) % mQueueCount];
+    std::unique_lock<std::mutex> lock(other.mMutex);
+    if (!other.mJobs.empty()) {
+      *job = std::move(other.mJobs.front());
+      other.mJobs.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkerPool::Run(std::function<void()>& job) {
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    --mQueuedJobs;
+  }
+  job();
+  job = nullptr;
+  std::unique_lock<std::mutex> lock(mMutex);
+  --mUnfinishedJobs;
+  if (mUnfinishedJobs == 0) {
+    mJobsFinished.notify_all();
+  }
+}
@@ -0,0 +1,64 @@
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <ds/Vector.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// A fixed set of threads that run enqueued jobs. Every thread has its own
+// queue. A thread runs the newest job of its own queue first and steals the
+// oldest job of another queue when its own is empty, so jobs that enqueue
+// more jobs keep their work local while idle threads balance the load. The
+// threads live as long as the pool, so enqueueing a job never creates a
+// thread.
+struct WorkerPool {
+  // A thread count of 0 uses the hardware concurrency.
+  WorkerPool(unsigned int threadCount = 0);
+  WorkerPool(const WorkerPool& other) = delete;
+  WorkerPool& operator=(const WorkerPool& other) = delete;
+  // Finishes every queued job before the threads are joined.
+  ~WorkerPool();
+
+  // Jobs enqueued by a pool thread go to that thread's queue. Others are
+  // spread over the queues in turn.
+  void Enqueue(std::function<void()> job);
+  // Blocks until every job enqueued so far has finished. The calling thread
+  // runs queued jobs while it waits.
+  void Wait();
+  size_t ThreadCount() const;
+
+private:
+  struct Queue {
+    std::mutex mMutex;
+    std::deque<std::function<void()>> mJobs;
+  };
+
+  void Work(unsigned int queue);
+  // Takes the newest job of the given queue or steals the oldest job of
+  // another. A queue of smNoQueue only steals.
+  bool Take(unsigned int queue, std::function<void()>* job);
+  void Run(std::function<void()>& job);
+
+  static constexpr unsigned int smNoQueue = (unsigned int)-1;
+  unsigned int mQueueCount;
+  std::unique_ptr<Queue[]> mQueues;
+  std::atomic<unsigned int> mNextQueue;
+
+  std::mutex mMutex;
+  std::condition_variable mJobQueued;
+  std::condition_variable mJobsFinished;
+  // Jobs that were enqueued and not yet taken. A job can be taken before its
+  // enqueue is counted, so the count can briefly be negative.
+  long mQueuedJobs;
+  // Jobs that were enqueued and have not finished.
+  size_t mUnfinishedJobs;
+  bool mStopping;
+  Ds::Vector<std::thread> mThreads;
+};
+
+#endif